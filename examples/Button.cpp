@@ -27,6 +27,8 @@
 #include "RkEvent.h"
 #include "RkButton.h"
 #include "RkLabel.h"
+#include "RkImageRegistry.h"
+#include "RkImageAtlas.h"
 #include "RkLog.h"
 
 RK_DECLARE_IMAGE_RC(button_up);
@@ -47,21 +49,23 @@ int main(int arc, char **argv)
     button1->setCheckable(true);
     button1->setSize(48, 48);
     button1->setPosition(x, 10);
-    button1->setImage(RkImage(48, 48, RK_IMAGE_RC(button_down)),
+    // All the button1 images are packed into one surface.
+    RkImageAtlas atlas(RkSize(128, 128));
+    button1->setImage(atlas.add(RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_down))),
                       RkButton::State::Pressed);
     {
-            auto hover = RkImage(48, 48, RK_IMAGE_RC(button_down));
+            auto hover = RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_down));
             RkPainter paint(&hover);
             paint.applyAlpha(100);
-            button1->setImage(hover, RkButton::State::PressedHover);
+            button1->setImage(atlas.add(hover), RkButton::State::PressedHover);
     }
-    button1->setImage(RkImage(48, 48, RK_IMAGE_RC(button_up)),
+    button1->setImage(atlas.add(RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_up))),
                       RkButton::State::Unpressed);
     {
-            auto hover = RkImage(48, 48, RK_IMAGE_RC(button_up));
+            auto hover = RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_up));
             RkPainter paint(&hover);
             paint.applyAlpha(100);
-            button1->setImage(hover, RkButton::State::UnpressedHover);
+            button1->setImage(atlas.add(hover), RkButton::State::UnpressedHover);
     }
     button1->show();
     RK_ACT_BINDL(button1, toggled, RK_ACT_ARGS(bool b),
@@ -78,9 +82,9 @@ int main(int arc, char **argv)
     button2->setText("Text");
     button2->setSize(48, 48);
     button2->setPosition(x, 10);
-    button2->setImage(RkImage(48, 48, RK_IMAGE_RC(button_down)),
+    button2->setImage(RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_down)),
                       RkButton::State::Pressed);
-    button2->setImage(RkImage(48, 48, RK_IMAGE_RC(button_up)),
+    button2->setImage(RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_up)),
                       RkButton::State::Unpressed);
     button2->show();
     RK_ACT_BINDL(button2, toggled, RK_ACT_ARGS(bool b),
@@ -96,9 +100,9 @@ int main(int arc, char **argv)
     button3->setType(RkButton::ButtonType::ButtonPush);
     button3->setSize(48, 48);
     button3->setPosition(x, 10);
-    button3->setImage(RkImage(48, 48, RK_IMAGE_RC(button_down)),
+    button3->setImage(RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_down)),
                       RkButton::State::Pressed);
-    button3->setImage(RkImage(48, 48, RK_IMAGE_RC(button_up)),
+    button3->setImage(RkImageRegistry::image(48, 48, RK_IMAGE_RC(button_up)),
                       RkButton::State::Unpressed);
     button3->show();
     RK_ACT_BINDL(button3, toggled, RK_ACT_ARGS(bool b),
@@ -108,6 +112,11 @@ int main(int arc, char **argv)
     label->setPosition({button3->x(), button3->y() + button3->height() + 5});
     label->show();
 
+    auto stats = RkImageRegistry::statistics();
+    RK_LOG_INFO("image registry: " << stats.images << " images, "
+                << stats.bytesResident << " bytes, hit rate: " << stats.hitRate());
+    RK_UNUSED(stats);
+
     return app.exec();
 }
 
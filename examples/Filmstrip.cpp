@@ -0,0 +1,92 @@
+/**
+ * File name: Filmstrip.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2020 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkMain.h"
+#include "RkWidget.h"
+#include "RkPainter.h"
+#include "RkFilmstrip.h"
+#include "RkLog.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+// Renders a strip of knob frames, one below the other.
+static RkImage createKnobStrip(int size, int frames)
+{
+    RkImage strip(size, size * frames);
+    RkPainter painter(&strip);
+    painter.fillRect(RkRect(0, 0, size, size * frames), RkColor(60, 60, 60));
+    RkPen pen(RkColor(220, 220, 220));
+    pen.setWidth(2);
+    painter.setPen(pen);
+    for (int i = 0; i < frames; i++) {
+            RkPoint center(size / 2, i * size + size / 2);
+            painter.drawCircle(center, size / 2 - 2);
+            auto angle = (-135.0 + 270.0 * i / (frames - 1)) * M_PI / 180;
+            RkPoint end(center.x() + std::sin(angle) * (size / 2 - 4),
+                        center.y() - std::cos(angle) * (size / 2 - 4));
+            painter.drawLine(center, end);
+    }
+    return strip;
+}
+
+int main(int arc, char **argv)
+{
+    RkMain app(arc, argv);
+
+    auto widget = new RkWidget(&app);
+    widget->setTitle("Filmstrip Example");
+    widget->setSize(440, 440);
+    widget->show();
+
+    // All the knobs share the same strip image.
+    auto strip = createKnobStrip(32, 64);
+    std::vector<RkFilmstrip*> knobs;
+    for (int i = 0; i < 100; i++) {
+            auto knob = new RkFilmstrip(widget);
+            knob->setImage(strip, 64);
+            knob->setPosition(10 + (i % 10) * 42, 10 + (i / 10) * 42);
+            knob->show();
+            RK_ACT_BINDL(knob, valueChanged, RK_ACT_ARGS(rk_real value),
+                         [i](rk_real value){ RK_LOG_INFO("knob " << i << ": " << value); });
+            knobs.push_back(knob);
+    }
+
+    // Automation: values are set from another thread.
+    std::atomic<bool> running{true};
+    std::thread automation([&knobs, &running](){
+            rk_real phase = 0;
+            while (running) {
+                    for (size_t i = 0; i < knobs.size(); i++)
+                            knobs[i]->setValue(0.5 + 0.5 * std::sin(phase + i * 0.1));
+                    phase += 0.01;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+    });
+
+    auto res = app.exec();
+    running = false;
+    automation.join();
+    return res;
+}
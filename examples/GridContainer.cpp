@@ -0,0 +1,82 @@
+/**
+ * File name: GridContainer.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkMain.h"
+#include "RkWidget.h"
+#include "RkGridContainer.h"
+#include "RkEvent.h"
+
+/**
+ * A grid of 300 widgets with a header row and a spanning footer. The
+ * window can be resized, the stretched columns and rows share the space.
+ */
+class MainWindow: public RkWidget {
+ public:
+        MainWindow(RkMain *app)
+                : RkWidget(app)
+                , gridContainer{nullptr}
+        {
+                setTitle("Grid Container Example");
+                setSize(600, 400);
+                gridContainer = new RkGridContainer(this);
+                gridContainer->setSpacing(2);
+                for (int column = 0; column < 10; column++) {
+                        addCell({180, 180, 180}, 0, column);
+                        gridContainer->setColumnStretch(column, column % 2 ? 2 : 1);
+                }
+                for (int row = 1; row < 31; row++) {
+                        for (int column = 0; column < 10; column++)
+                                addCell({60, 100 + 4 * row, 160}, row, column);
+                }
+                addCell({200, 120, 60}, 31, 0, 10);
+                gridContainer->setRowStretch(31, 1);
+        }
+
+ protected:
+        void resizeEvent(RkResizeEvent *event) override
+        {
+                RK_UNUSED(event);
+                gridContainer->setSize(size());
+        }
+
+ private:
+        void addCell(const RkColor &color, int row, int column, int columnSpan = 1)
+        {
+                auto widget = new RkWidget(this);
+                widget->setBackgroundColor(color);
+                widget->setMinimumWidth(8);
+                widget->setSize(20, 10);
+                widget->show();
+                gridContainer->addWidget(widget, row, column, 1, columnSpan);
+        }
+
+        RkGridContainer *gridContainer;
+};
+
+int main(int arc, char **argv)
+{
+	RkMain app(arc, argv);
+	auto widget = new MainWindow(&app);
+	widget->show();
+	return app.exec();
+}
@@ -24,6 +24,7 @@
 #include "RkMain.h"
 #include "RkWidget.h"
 #include "RkPainter.h"
+#include "RkPicture.h"
 #include "RkPoint.h"
 #include "RkLog.h"
 #include "RkEvent.h"
@@ -57,15 +58,10 @@ class  PainterExample: public RkWidget {
                  */
                 if (startDraw) {
 
-                        // Create the image if the widget size changed or if the image was not created.
-                        if (image.width() != width() || image.height() != height()) {
-                                RkImage im(width(), height());
-                                // Because there is no copy constructor developed yet for RkImage.
-                                image = im;
-                        }
-
-                        // Use RkPainter to draw on the image.
-                        RkPainter painter(&image);
+                        // Record the drawing into a picture. Recording is cheap,
+                        // the image is rasterized only when the drawing changed.
+                        RkPicture picture;
+                        RkPainter painter(&picture);
 
                         // Fill the rect with the widget background color.
                         painter.fillRect(rect(), background());
@@ -115,6 +111,19 @@ class  PainterExample: public RkWidget {
                         painter.drawText({50, y, 100, 25}, "Hello!", Rk::Alignment::AlignRight);
                         painter.drawRect(RkRect(50, y, 100, 25));
 
+                        // Create the image if the widget size changed or if the image was not created.
+                        if (image.width() != width() || image.height() != height()) {
+                                image = RkImage(width(), height());
+                                imagePicture.clear();
+                        }
+
+                        // Replay the picture on the image only if it differs from the last one.
+                        if (picture != imagePicture) {
+                                RkPainter imagePainter(&image);
+                                imagePainter.drawPicture(picture);
+                                imagePicture = picture;
+                        }
+
                         // Create the RkPainter that will draw on widget.
                         RK_LOG_INFO("-----------------> RkPainter");
                         RkPainter paint(this);
@@ -145,6 +154,7 @@ class  PainterExample: public RkWidget {
         RkPoint clickPoint;
         bool startDraw;
         RkImage image;
+        RkPicture imagePicture;
 };
 
 int main(int arc, char **argv)
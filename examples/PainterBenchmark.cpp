@@ -0,0 +1,100 @@
+/**
+ * File name: PainterBenchmark.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPainter.h"
+#include "RkImage.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+/**
+ * Compares drawing the same primitives one call per item with the batched
+ * RkPainter calls, which make one stroke or fill per color.
+ */
+
+constexpr int imageWidth = 800;
+constexpr int imageHeight = 600;
+constexpr int primitives = 200;
+constexpr int frames = 500;
+
+static void measure(const std::string &name, const std::function<void(RkPainter&)> &draw)
+{
+        RkImage image(imageWidth, imageHeight);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++) {
+                RkPainter painter(&image);
+                draw(painter);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": "
+                  << static_cast<long>(primitives * frames / elapsed.count())
+                  << " primitives/s" << std::endl;
+}
+
+int main()
+{
+        std::vector<RkPoint> lines;
+        std::vector<RkRect> rects;
+        std::vector<RkPoint> points;
+        std::vector<RkColor> colors;
+        for (int i = 0; i < primitives; i++) {
+                int x = (i * 4) % imageWidth;
+                lines.push_back(RkPoint(x, 0));
+                lines.push_back(RkPoint(x, imageHeight - 1));
+                rects.push_back(RkRect(x, (i * 7) % (imageHeight - 10), 3, 10));
+                points.push_back(RkPoint(x, (i * 13) % imageHeight));
+                // A level meter: green, yellow and red segments.
+                colors.push_back(i < 140 ? RkColor(0, 200, 0) : (i < 180 ? RkColor(220, 220, 0) : RkColor(220, 0, 0)));
+        }
+
+        measure("drawLine", [&](RkPainter &painter) {
+                        for (size_t i = 0; i < lines.size(); i += 2)
+                                painter.drawLine(lines[i], lines[i + 1]);
+                });
+        measure("drawLines", [&](RkPainter &painter) {
+                        painter.drawLines(lines);
+                });
+        measure("drawRect", [&](RkPainter &painter) {
+                        for (const auto &rect: rects)
+                                painter.drawRect(rect);
+                });
+        measure("drawRects", [&](RkPainter &painter) {
+                        painter.drawRects(rects);
+                });
+        measure("fillRect (per item color)", [&](RkPainter &painter) {
+                        for (size_t i = 0; i < rects.size(); i++)
+                                painter.fillRect(rects[i], colors[i]);
+                });
+        measure("fillRects (per item color)", [&](RkPainter &painter) {
+                        painter.fillRects(rects, colors);
+                });
+        measure("fillRect per point", [&](RkPainter &painter) {
+                        for (const auto &point: points)
+                                painter.fillRect(RkRect(point.x(), point.y(), 1, 1), painter.pen().color());
+                });
+        measure("drawPoints", [&](RkPainter &painter) {
+                        painter.drawPoints(points);
+                });
+        return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * File name: PixelOpsBenchmark.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPixelOps.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * Measures the pixel operations for each backend supported by the CPU,
+ * in GB/s of destination pixels, and checks that the SIMD backends give
+ * the same pixels as the scalar code.
+ */
+
+constexpr size_t benchmarkPixels = 1 << 20;
+constexpr int benchmarkRuns = 200;
+// Odd lengths, so the SIMD loops also go through their scalar tails.
+constexpr size_t checkLengths[] = {0, 1, 3, 7, 15, 33, 1021, 4099};
+
+using Operation = std::function<void(uint32_t *dst, size_t n)>;
+
+struct NamedOperation {
+        const char *name;
+        Operation operation;
+};
+
+static const char* backendName(RkPixelOps::Backend backend)
+{
+        switch (backend) {
+        case RkPixelOps::Backend::AVX2:
+                return "AVX2";
+        case RkPixelOps::Backend::SSE2:
+                return "SSE2";
+        default:
+                return "Scalar";
+        }
+}
+
+static std::vector<uint32_t> randomPixels(std::mt19937 &generator, size_t n)
+{
+        std::uniform_int_distribution<uint32_t> distribution;
+        std::vector<uint32_t> pixels(n);
+        for (auto &pixel: pixels)
+                pixel = distribution(generator);
+        return pixels;
+}
+
+static bool check(const NamedOperation &op, RkPixelOps::Backend backend, std::mt19937 &generator)
+{
+        for (auto n: checkLengths) {
+                // One pixel of offset, so the SIMD loads are unaligned.
+                auto dst = randomPixels(generator, n + 1);
+                auto expected = dst;
+                RkPixelOps::setBackend(RkPixelOps::Backend::Scalar);
+                op.operation(expected.data() + 1, n);
+                RkPixelOps::setBackend(backend);
+                op.operation(dst.data() + 1, n);
+                for (size_t i = 0; i < dst.size(); i++) {
+                        if (dst[i] != expected[i]) {
+                                std::cout << op.name << " (" << backendName(backend) << "): pixel "
+                                          << i << " of " << n << " is " << std::hex << dst[i]
+                                          << " instead of " << expected[i] << std::dec << std::endl;
+                                return false;
+                        }
+                }
+        }
+        return true;
+}
+
+static void measure(const NamedOperation &op, std::mt19937 &generator)
+{
+        auto dst = randomPixels(generator, benchmarkPixels);
+        // Warm up the caches and the page mappings.
+        op.operation(dst.data(), dst.size());
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < benchmarkRuns; i++)
+                op.operation(dst.data(), dst.size());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double bytes = static_cast<double>(benchmarkPixels) * sizeof(uint32_t) * benchmarkRuns;
+        std::cout << "  " << op.name << ": " << bytes / elapsed.count() / 1e9 << " GB/s" << std::endl;
+}
+
+int main()
+{
+        std::vector<NamedOperation> operations = {
+                {"fill", [](uint32_t *dst, size_t n) {
+                                RkPixelOps::fill(dst, n, 0x80402010);
+                        }},
+                {"applyAlpha", [](uint32_t *dst, size_t n) {
+                                RkPixelOps::applyAlpha(dst, n, 170);
+                        }}
+        };
+
+        std::mt19937 generator(1);
+        auto supported = RkPixelOps::backend();
+        bool equal = true;
+        for (int level = 0; level <= static_cast<int>(supported); level++) {
+                auto backend = static_cast<RkPixelOps::Backend>(level);
+                std::cout << backendName(backend) << ":" << std::endl;
+                for (const auto &op: operations) {
+                        if (backend != RkPixelOps::Backend::Scalar && !check(op, backend, generator))
+                                equal = false;
+                        RkPixelOps::setBackend(backend);
+                        measure(op, generator);
+                }
+        }
+        RkPixelOps::setBackend(supported);
+
+        std::cout << (equal ? "The SIMD backends match the scalar code"
+                      : "The SIMD backends differ from the scalar code") << std::endl;
+        return equal ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/**
+ * File name: ProxyModelBenchmark.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkProxyModel.h"
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * Measures the latency of filtering a sorted proxy of a big model per
+ * keystroke, as when a query is typed in a search field.
+ */
+
+constexpr size_t samplesNumber = 1000000;
+
+class SampleModel: public RkModel {
+ public:
+        SampleModel()
+                : RkModel(nullptr)
+        {
+                const char* names[] = {"Kick", "Snare", "HiHat", "Tom", "Clap", "Crash", "Ride", "Perc"};
+                sampleNames.reserve(samplesNumber);
+                for (size_t i = 0; i < samplesNumber; i++) {
+                        auto id = (i * 7919) % samplesNumber;
+                        sampleNames.push_back(std::string(names[id % 8]) + "_" + std::to_string(id) + ".wav");
+                }
+        }
+
+        RkVariant itemData(size_t index, int dataType) const override
+        {
+                if (dataType == static_cast<int>(RkModelItem::DataType::String))
+                        return sampleNames[index];
+                return RkVariant();
+        }
+
+        size_t itemsNumber() const override { return sampleNames.size(); }
+        int itemSpan() const override { return 20; }
+
+        void itemsData(size_t first, size_t count, int dataTypes, RkModelRow *rows) const override
+        {
+                for (size_t i = 0; i < count; i++) {
+                        rows[i] = RkModelRow();
+                        if (dataTypes & dataTypeMask(RkModelItem::DataType::String))
+                                rows[i].text = sampleNames[first + i];
+                }
+        }
+
+ private:
+        std::vector<std::string> sampleNames;
+};
+
+template<class Function>
+static double measure(Function function)
+{
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+}
+
+int main()
+{
+        SampleModel model;
+        RkProxyModel proxy(nullptr, &model);
+        std::cout << "items: " << proxy.itemsNumber() << std::endl;
+        std::cout << "sort: "
+                  << measure([&] { proxy.setSortOrder(RkProxyModel::SortOrder::Ascending); })
+                  << " ms" << std::endl;
+
+        const std::string query = "snare_12";
+        for (size_t i = 1; i <= query.size(); i++) {
+                auto ms = measure([&] { proxy.setFilter(query.substr(0, i)); });
+                std::cout << "filter \"" << query.substr(0, i) << "\": " << ms << " ms, "
+                          << proxy.itemsNumber() << " items" << std::endl;
+        }
+        for (size_t i = query.size() - 1; i > 0; i--) {
+                auto ms = measure([&] { proxy.setFilter(query.substr(0, i)); });
+                std::cout << "backspace \"" << query.substr(0, i) << "\": " << ms << " ms, "
+                          << proxy.itemsNumber() << " items" << std::endl;
+        }
+        return 0;
+}
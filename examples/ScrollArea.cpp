@@ -0,0 +1,92 @@
+/**
+ * File name: ScrollArea.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkMain.h"
+#include "RkScrollArea.h"
+#include "RkPainter.h"
+#include "RkTimer.h"
+#include "RkLog.h"
+
+#include <chrono>
+
+// A long timeline, each tile is drawn once and then scrolled from the cache.
+class Timeline: public RkScrollArea {
+ public:
+        Timeline(RkWidget *parent)
+                : RkScrollArea(parent)
+        {
+                setContentSize(RkSize(20000, 400));
+        }
+
+ protected:
+        void paintContent(RkPainter &painter, const RkRect &rect) override
+        {
+                RkPen pen(RkColor(200, 200, 200));
+                painter.setPen(pen);
+                auto first = rect.left() - rect.left() % 50;
+                for (auto x = first; x < rect.right() + 50; x += 50) {
+                        painter.drawLine(x, 0, x, x % 500 ? 10 : 20);
+                        if (x % 500 == 0)
+                                painter.drawText(x + 3, 32, std::to_string(x / 50) + " s");
+                }
+                for (auto x = first; x < rect.right() + 50; x += 50)
+                        painter.fillRect(RkRect(x + 5, 60 + (x / 50 * 37) % 300, 40, 20),
+                                         RkColor(90, 160, 220));
+        }
+};
+
+int main(int arc, char **argv)
+{
+        RkMain app(arc, argv);
+
+        auto mainWindow = new RkWidget(&app);
+        mainWindow->setTitle("Scroll Area Example");
+        mainWindow->setSize(600, 400);
+
+        auto timeline = new Timeline(mainWindow);
+        timeline->setBackgroundColor(40, 40, 40);
+        timeline->setSize(mainWindow->size());
+        timeline->show();
+
+        // Scrolls with a 16 ms timer and reports the achieved rate.
+        auto timer = new RkTimer(mainWindow, 16);
+        auto frames = std::make_shared<int>(0);
+        auto start = std::make_shared<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
+        auto scroll = [timeline, frames, start]() {
+                if (timeline->scrollPosition().x() == timeline->maxScrollPosition().x())
+                        timeline->setScrollPosition(RkPoint(0, 0));
+                else
+                        timeline->scrollBy(9, 0);
+                if (++(*frames) == 600) {
+                        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - *start;
+                        RK_LOG_INFO("scrolling: " << *frames / elapsed.count() << " frames/s");
+                        *frames = 0;
+                        *start = std::chrono::steady_clock::now();
+                }
+        };
+        RK_ACT_BINDL(timer, timeout, RK_ACT_ARGS(), scroll);
+        timer->start();
+
+        mainWindow->show();
+        return app.exec();
+}
@@ -0,0 +1,101 @@
+/**
+ * File name: TableView.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkMain.h"
+#include "RkWidget.h"
+#include "RkTableView.h"
+#include "RkTimer.h"
+#include "RkLog.h"
+
+#include <chrono>
+
+// A million samples, the cells are made when they are fetched.
+class SamplesModel: public RkModel {
+ public:
+        enum Column : int {
+                Name = static_cast<int>(RkModelItem::DataType::String),
+                Length = static_cast<int>(RkModelItem::DataType::UserType),
+                Rate = static_cast<int>(RkModelItem::DataType::UserType) + 1
+        };
+
+        SamplesModel(RkObject *parent)
+                : RkModel(parent)
+        {
+        }
+
+        RkVariant itemData(size_t index, int dataType) const override
+        {
+                switch (dataType) {
+                case Name:
+                        return "Sample_" + std::to_string(index) + ".wav";
+                case Length:
+                        return std::to_string((index * 7919) % 60000) + " ms";
+                case Rate:
+                        return index % 2 ? std::string("48000 Hz") : std::string("44100 Hz");
+                case static_cast<int>(RkModelItem::DataType::Color):
+                        return index % 10 ? RkColor(220, 220, 220) : RkColor(250, 200, 100);
+                default:
+                        return RkVariant();
+                }
+        }
+
+        size_t itemsNumber() const override { return 1000000; }
+        int itemSpan() const override { return 20; }
+};
+
+int main(int arc, char **argv)
+{
+        RkMain app(arc, argv);
+
+        auto mainWindow = new RkWidget(&app);
+        mainWindow->setTitle("Table View Example");
+        mainWindow->setSize(500, 400);
+
+        auto model = new SamplesModel(mainWindow);
+        auto table = new RkTableView(mainWindow, model);
+        table->setBackgroundColor(40, 40, 40);
+        table->setSize(mainWindow->size());
+        table->addColumn("Name", 200, SamplesModel::Name);
+        table->addColumn("Length", 120, SamplesModel::Length);
+        table->addColumn("Rate", 120, SamplesModel::Rate);
+        table->show();
+
+        // Scrolls down at 60 frames per second and reports the rate.
+        auto timer = new RkTimer(mainWindow, 16);
+        auto frames = std::make_shared<int>(0);
+        auto start = std::make_shared<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
+        auto scroll = [table, frames, start]() {
+                table->setScrollOffset(table->scrollOffset() + 7);
+                if (++(*frames) == 600) {
+                        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - *start;
+                        RK_LOG_INFO("scrolling: " << *frames / elapsed.count() << " frames/s");
+                        *frames = 0;
+                        *start = std::chrono::steady_clock::now();
+                }
+        };
+        RK_ACT_BINDL(timer, timeout, RK_ACT_ARGS(), scroll);
+        timer->start();
+
+        mainWindow->show();
+        return app.exec();
+}
@@ -0,0 +1,163 @@
+/**
+ * File name: TreeViewRows.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkMain.h"
+#include "RkWidget.h"
+#include "RkTreeView.h"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+/**
+ * Checks the rows of RkTreeView against the model after expanding,
+ * collapsing and changing nodes. The steps expand a node below a row that
+ * was found before other rows were inserted above it, the row index of
+ * the view must not keep the old row for it.
+ */
+
+class NamesModel: public RkTreeModel {
+ public:
+        NamesModel(RkObject *parent)
+                : RkTreeModel(parent)
+                , nextNode{1}
+        {
+        }
+
+        NodeId add(NodeId parent, const std::string &name)
+        {
+                auto node = nextNode++;
+                nodeNames[node] = name;
+                nodeChildren[parent].push_back(node);
+                notifyChildrenInserted(parent, nodeChildren[parent].size() - 1, nodeChildren[parent].size() - 1);
+                return node;
+        }
+
+        void removeFirst(NodeId parent)
+        {
+                auto &children = nodeChildren[parent];
+                if (children.empty())
+                        return;
+                children.erase(children.begin());
+                notifyChildrenRemoved(parent, 0, 0);
+        }
+
+        size_t childrenNumber(NodeId parent) const override
+        {
+                auto res = nodeChildren.find(parent);
+                return res != nodeChildren.end() ? res->second.size() : 0;
+        }
+
+        NodeId child(NodeId parent, size_t index) const override
+        {
+                return nodeChildren.at(parent)[index];
+        }
+
+        RkVariant nodeData(NodeId node, int dataType) const override
+        {
+                if (dataType != static_cast<int>(RkModelItem::DataType::String))
+                        return RkVariant();
+                return nodeNames.at(node);
+        }
+
+        int itemSpan() const override { return 20; }
+
+        const std::string& name(NodeId node) const
+        {
+                return nodeNames.at(node);
+        }
+
+ private:
+        NodeId nextNode;
+        std::map<NodeId, std::string> nodeNames;
+        std::map<NodeId, std::vector<NodeId>> nodeChildren;
+};
+
+static void expectedRows(const NamesModel &model,
+                         const RkTreeView &view,
+                         RkTreeModel::NodeId parent,
+                         std::vector<RkTreeModel::NodeId> &rows)
+{
+        for (size_t i = 0; i < model.childrenNumber(parent); i++) {
+                auto node = model.child(parent, i);
+                rows.push_back(node);
+                if (view.isExpanded(node))
+                        expectedRows(model, view, node, rows);
+        }
+}
+
+static bool check(const NamesModel &model, const RkTreeView &view, const std::string &step)
+{
+        std::vector<RkTreeModel::NodeId> rows;
+        expectedRows(model, view, RkTreeModel::rootNode, rows);
+        bool equal = rows.size() == view.rowsNumber();
+        for (size_t i = 0; equal && i < rows.size(); i++)
+                equal = view.nodeAt(static_cast<int>(i) * model.itemSpan() - view.scrollOffset()) == rows[i];
+
+        std::cout << step << ":";
+        for (size_t i = 0; i < view.rowsNumber(); i++)
+                std::cout << " " << model.name(view.nodeAt(static_cast<int>(i) * model.itemSpan() - view.scrollOffset()));
+        std::cout << (equal ? "" : " (wrong rows)") << std::endl;
+        return equal;
+}
+
+int main(int arc, char **argv)
+{
+        RkMain app(arc, argv);
+        auto mainWindow = new RkWidget(&app);
+        mainWindow->setSize(300, 400);
+
+        auto model = new NamesModel(mainWindow);
+        auto view = new RkTreeView(mainWindow, model);
+        view->setSize(mainWindow->size());
+        auto a = model->add(RkTreeModel::rootNode, "A");
+        auto p = model->add(RkTreeModel::rootNode, "P");
+        model->add(RkTreeModel::rootNode, "Q");
+        auto b = model->add(RkTreeModel::rootNode, "B");
+        model->add(a, "a1");
+        model->add(a, "a2");
+        model->add(b, "b1");
+        model->add(b, "b2");
+
+        bool ok = check(*model, *view, "rows");
+        view->expand(b);
+        ok = check(*model, *view, "expand B") && ok;
+        view->expand(a);
+        ok = check(*model, *view, "expand A") && ok;
+        // Finds the row of P, it indexes the rows up to P and not the moved B.
+        view->expand(p);
+        ok = check(*model, *view, "expand P") && ok;
+        view->collapse(b);
+        ok = check(*model, *view, "collapse B") && ok;
+        view->expand(b);
+        ok = check(*model, *view, "expand B") && ok;
+        model->add(b, "b3");
+        ok = check(*model, *view, "insert b3") && ok;
+        model->removeFirst(b);
+        ok = check(*model, *view, "remove b1") && ok;
+        model->removeFirst(a);
+        ok = check(*model, *view, "remove a1") && ok;
+
+        std::cout << (ok ? "The rows match the model" : "The rows differ from the model") << std::endl;
+        return ok ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+/**
+ * File name: WidgetIndex.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkMain.h"
+#include "RkWidget.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+
+/**
+ * Builds a deep tree of widgets and checks RkWidget::widgetAt() and
+ * widgetsIn() against a walk of the tree while the widgets are moved,
+ * hidden and resized, then measures the queries.
+ */
+
+constexpr int treeDepth = 6;
+constexpr int treeChildren = 3;
+constexpr int operations = 2000;
+constexpr int queries = 100000;
+
+struct Node {
+        RkWidget *widget;
+        // In the creation order, the later children are above.
+        std::vector<size_t> children;
+};
+
+class WidgetTree {
+ public:
+        WidgetTree(RkMain *app)
+                : generator{1}
+        {
+                auto top = new RkWidget(app);
+                top->setSize(800, 600);
+                top->show();
+                treeNodes.push_back({top, {}});
+                addChildren(0, 1);
+        }
+
+        RkWidget* top() const
+        {
+                return treeNodes.front().widget;
+        }
+
+        // Moves, hides or resizes a random widget below the top one.
+        void change()
+        {
+                auto widget = treeNodes[1 + random(treeNodes.size() - 1)].widget;
+                switch (random(4)) {
+                case 0:
+                        widget->setPosition(random(300) - 20, random(200) - 20);
+                        break;
+                case 1:
+                {
+                        // Covers the parent, then moves without changing the visible
+                        // rectangle, only the origin of the children.
+                        auto size = widget->parentWidget()->size();
+                        widget->setSize(size.width() + 40, size.height() + 40);
+                        widget->setPosition(-10 - random(6), -10 - random(6));
+                        widget->setPosition(widget->x() + random(9) - 4, widget->y() + random(9) - 4);
+                        break;
+                }
+                case 2:
+                        widget->show(!widget->isShown());
+                        break;
+                default:
+                        widget->setSize(1 + random(400), 1 + random(300));
+                }
+        }
+
+        void showAll()
+        {
+                for (const auto &node: treeNodes)
+                        node.widget->show();
+        }
+
+        RkPoint randomPoint()
+        {
+                return RkPoint(random(840) - 20, random(640) - 20);
+        }
+
+        RkRect randomRect()
+        {
+                return RkRect(randomPoint(), RkSize(1 + random(200), 1 + random(200)));
+        }
+
+        // The topmost widget found by walking the tree.
+        RkWidget* expectedWidgetAt(const RkPoint &point) const
+        {
+                RkWidget *hit = nullptr;
+                walk([&](RkWidget *widget, const RkRect &rect) {
+                                if (rect.contains(point))
+                                        hit = widget;
+                        });
+                return hit;
+        }
+
+        std::vector<RkWidget*> expectedWidgetsIn(const RkRect &area) const
+        {
+                std::vector<RkWidget*> widgets;
+                walk([&](RkWidget *widget, const RkRect &rect) {
+                                if (rect.intersects(area))
+                                        widgets.push_back(widget);
+                        });
+                return widgets;
+        }
+
+ private:
+        void addChildren(size_t parent, int depth)
+        {
+                if (depth > treeDepth)
+                        return;
+                for (int i = 0; i < treeChildren; i++) {
+                        auto widget = new RkWidget(treeNodes[parent].widget);
+                        widget->setPosition(random(200) - 10, random(150) - 10);
+                        widget->setSize(20 + random(400), 20 + random(300));
+                        widget->show();
+                        treeNodes[parent].children.push_back(treeNodes.size());
+                        treeNodes.push_back({widget, {}});
+                        addChildren(treeNodes.size() - 1, depth + 1);
+                }
+        }
+
+        // Calls f from the bottom to the top for the shown widgets with their visible rectangle.
+        void walk(const std::function<void(RkWidget*, const RkRect&)> &f) const
+        {
+                std::function<void(size_t, const RkPoint&, const RkRect&)> visit;
+                visit = [&](size_t node, const RkPoint &origin, const RkRect &clip) {
+                        auto widget = treeNodes[node].widget;
+                        if (!widget->isShown())
+                                return;
+                        auto rect = RkRect(origin, widget->size()).intersected(clip);
+                        if (rect.area() <= 0)
+                                return;
+                        f(widget, rect);
+                        for (auto child: treeNodes[node].children) {
+                                auto position = treeNodes[child].widget->position();
+                                visit(child, RkPoint(origin.x() + position.x(), origin.y() + position.y()), rect);
+                        }
+                };
+                visit(0, RkPoint(0, 0), RkRect(RkPoint(0, 0), top()->size()));
+        }
+
+        int random(size_t n)
+        {
+                return static_cast<int>(generator() % n);
+        }
+
+        std::mt19937 generator;
+        std::vector<Node> treeNodes;
+};
+
+template<class Query>
+static double measure(Query query)
+{
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < queries; i++)
+                query();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / queries;
+}
+
+int main(int arc, char **argv)
+{
+        RkMain app(arc, argv);
+        WidgetTree tree(&app);
+        auto top = tree.top();
+
+        for (int i = 0; i < operations; i++) {
+                tree.change();
+                for (int j = 0; j < 20; j++) {
+                        auto point = tree.randomPoint();
+                        if (top->widgetAt(point) != tree.expectedWidgetAt(point)) {
+                                std::cout << "widgetAt(" << point.x() << ", " << point.y()
+                                          << ") differs after " << i + 1 << " changes" << std::endl;
+                                return 1;
+                        }
+                }
+                auto rect = tree.randomRect();
+                if (top->widgetsIn(rect) != tree.expectedWidgetsIn(rect)) {
+                        std::cout << "widgetsIn() differs after " << i + 1 << " changes" << std::endl;
+                        return 1;
+                }
+        }
+        std::cout << "widgetAt() and widgetsIn() match the tree after "
+                  << operations << " changes" << std::endl;
+
+        tree.showAll();
+        std::vector<RkPoint> points;
+        std::vector<RkRect> rects;
+        for (int i = 0; i < 1024; i++) {
+                points.push_back(tree.randomPoint());
+                rects.push_back(tree.randomRect());
+        }
+        size_t n = 0;
+        size_t hits = 0;
+        auto widgetAtTime = measure([&] {
+                        hits += top->widgetAt(points[n++ % points.size()]) != nullptr;
+                });
+        auto walkTime = measure([&] {
+                        hits += tree.expectedWidgetAt(points[n++ % points.size()]) != nullptr;
+                });
+        auto widgetsInTime = measure([&] {
+                        hits += top->widgetsIn(rects[n++ % rects.size()]).size();
+                });
+        std::cout << "widgetAt: " << widgetAtTime << " us (tree walk: " << walkTime << " us)" << std::endl;
+        std::cout << "widgetsIn: " << widgetsInTime << " us" << std::endl;
+        std::cout << "hits: " << hits << std::endl;
+        return 0;
+}
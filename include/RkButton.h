@@ -26,6 +26,7 @@
 
 #include "RkWidget.h"
 #include "RkImage.h"
+#include "RkImageRegion.h"
 
 class RK_EXPORT RkButton: public RkWidget
 {
@@ -48,6 +49,7 @@ class RK_EXPORT RkButton: public RkWidget
         void setText(const std::string &text);
         std::string text() const;
         void setImage(const RkImage &img, State state = State::Unpressed);
+        void setImage(const RkImageRegion &region, State state = State::Unpressed);
         void setPressed(bool pressed);
         bool isPressed() const;
         ButtonType type() const;
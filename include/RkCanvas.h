@@ -33,6 +33,12 @@ class RK_EXPORT RkCanvas {
         RkCanvas() = default;
         virtual ~RkCanvas() = default;
         virtual const RkCanvasInfo* getCanvasInfo() const = 0;
+
+        /**
+         * Called by RkPainter before it starts drawing on the canvas.
+         * Canvases with shared storage must make it unique here.
+         */
+        virtual void beginPaint() {}
 };
 
 #endif // RK_CANVAS_H
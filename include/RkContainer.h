@@ -27,17 +27,27 @@
 #include "RkWidget.h"
 #include "RkContainerItem.h"
 
+/**
+ * Places the items in a row or in a column. Changing the container or
+ * adding items only marks the layout as dirty, the layout is made once
+ * when the event queue processes the actions, or by activate().
+ * Nested containers are laid out by the outer container in the same pass.
+ * Items with stretch grow from their size hint to share the free space,
+ * within their minimum and maximum size.
+ */
 class RK_EXPORT RkContainer: public RkContainerItem {
  public:
         RkContainer(RkWidget *parent  = nullptr, Rk::Orientation orientation = Rk::Orientation::Horizontal);
         virtual ~RkContainer() = default;
-        void addContainer(RkContainer *contaier, Rk::Alignment align = Rk::Alignment::AlignLeft);
-	void addWidget(RkWidget *widget, Rk::Alignment align = Rk::Alignment::AlignLeft);
+        void addContainer(RkContainerItem *contaier,
+                          Rk::Alignment align = Rk::Alignment::AlignLeft,
+                          int stretch = 0);
+	void addWidget(RkWidget *widget, Rk::Alignment align = Rk::Alignment::AlignLeft, int stretch = 0);
 	void removeWidget(RkWidget *widget);
-	void addSpace(int space, Rk::Alignment align = Rk::Alignment::AlignLeft);
+        void setStretch(RkWidget *widget, int stretch);
+	void addSpace(int space, Rk::Alignment align = Rk::Alignment::AlignLeft, int stretch = 0);
 	void removeAt(size_t index);
         RkContainerItem* at(size_t index) const;
-	void update();
 	void clear();
 	Rk::Orientation orientation() const;
 	Rk::Alignment alignment(RkWidget *widget) const;
@@ -55,6 +65,8 @@ class RK_EXPORT RkContainer: public RkContainerItem {
 
  protected:
 	int initPosition(Rk::Alignment alignment);
+        void layout() override;
+        RkContainerItem* widgetItem(RkWidget *widget) const;
 
  private:
         RK_DISABLE_COPY(RkContainer);
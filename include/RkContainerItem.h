@@ -26,6 +26,10 @@
 
 #include <RkWidget.h>
 
+/**
+ * An item of a container. Containers are items too, they mark
+ * themselves dirty when changed and are laid out by activate().
+ */
 class RK_EXPORT RkContainerItem: public RkObject {
  public:
         enum class ItemType : int {
@@ -39,7 +43,10 @@ class RK_EXPORT RkContainerItem: public RkObject {
                  : RkObject(parent)
                  , itemType{type}
                  , itemAlignment{align}
-                 , itemHidden{false} {}
+                 , itemHidden{false}
+                 , itemStretch{0}
+                 , itemDirty{false}
+                 , parentItem{nullptr} {}
         virtual ~RkContainerItem() = default;
         ItemType type() const { return itemType; }
         virtual void setPosition(const RkPoint &point) { itemPosition = point; }
@@ -58,6 +65,26 @@ class RK_EXPORT RkContainerItem: public RkObject {
         Rk::Alignment alignment() const { return itemAlignment; }
         virtual void hide(bool b) { itemHidden = b; }
         virtual bool isHidden() const { return itemHidden; }
+        virtual RkSize minimumSize() const { return RkSize(0, 0); }
+        virtual RkSize maximumSize() const { return RkSize(1000000, 1000000); }
+        // Items with stretch take the free space of the container, in proportion.
+        void setStretch(int stretch) { itemStretch = stretch; }
+        int stretch() const { return itemStretch; }
+        // The preferred size of a stretched item, taken when it is added.
+        void setSizeHint(const RkSize &size) { itemSizeHint = size; }
+        const RkSize& sizeHint() const { return itemSizeHint; }
+        // Lays out the item now.
+        void update();
+        // Marks the layout as changed, it is made at the next layout pass.
+        void invalidate();
+        // Lays out the item now if the layout was changed.
+        void activate();
+        bool isDirty() const { return itemDirty; }
+        void setParentContainer(RkContainerItem *container) { parentItem = container; }
+        RkContainerItem* parentContainer() const { return parentItem; }
+
+ protected:
+        virtual void layout() {}
 
  private:
         RK_DISABLE_COPY(RkContainerItem);
@@ -67,6 +94,10 @@ class RK_EXPORT RkContainerItem: public RkObject {
         ItemType itemType;
         Rk::Alignment itemAlignment;
         bool itemHidden;
+        int itemStretch;
+        RkSize itemSizeHint;
+        bool itemDirty;
+        RkContainerItem *parentItem;
 };
 
 #endif // RK_CONTAINER_ITEM_H
@@ -50,6 +50,8 @@ class RK_EXPORT RkContainerWidgetItem: public RkContainerItem {
         RkWidget* widget() const { return itemWidget; }
         void hide(bool b) override { return b ? itemWidget->hide() : itemWidget->show(); }
         bool isHidden() const override { return !itemWidget->isShown(); }
+        RkSize minimumSize() const override { return RkSize(itemWidget->minimumWidth(), itemWidget->minimumHeight()); }
+        RkSize maximumSize() const override { return RkSize(itemWidget->maximumWidth(), itemWidget->maximumHeight()); }
 
  private:
         RK_DISABLE_COPY(RkContainerWidgetItem);
@@ -0,0 +1,75 @@
+/**
+ * File name: RkFilmstrip.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_FILMSTRIP_H
+#define RK_FILMSTRIP_H
+
+#include "RkWidget.h"
+#include "RkImageRegion.h"
+
+/**
+ * Knob or slider drawn from a strip of pre-rendered frames.
+ * The value is mapped to a frame, and the widget is repainted only
+ * when the frame changes. setValue() can be called from any thread,
+ * the updates are coalesced into one repaint by the GUI thread.
+ * valueChanged is emitted only for changes made by the user.
+ */
+class RK_EXPORT RkFilmstrip : public RkWidget {
+ public:
+        explicit RkFilmstrip(RkWidget *parent);
+        virtual ~RkFilmstrip() = default;
+        void setImage(const RkImage &strip,
+                      int frames,
+                      Rk::Orientation orientation = Rk::Orientation::Vertical);
+        void setImage(const RkImageRegion &strip,
+                      int frames,
+                      Rk::Orientation orientation = Rk::Orientation::Vertical);
+        int frames() const;
+        int frame() const;
+        void setRange(rk_real begin, rk_real end);
+        rk_real beginValue() const;
+        rk_real endValue() const;
+        rk_real value() const;
+        void setValue(rk_real value);
+        // The mouse distance in pixels to drag over the whole range.
+        void setDragDistance(int distance);
+        int dragDistance() const;
+        RK_DECL_ACT(valueChanged,
+                    valueChanged(rk_real value),
+                    RK_ARG_TYPE(rk_real),
+                    RK_ARG_VAL(value));
+
+ protected:
+        virtual void mouseButtonPressEvent(RkMouseEvent *event) override;
+        virtual void mouseButtonReleaseEvent(RkMouseEvent *event) override;
+        virtual void mouseMoveEvent(RkMouseEvent *event) override;
+        virtual void paintEvent(RkPaintEvent *event) override;
+        void changeValue(rk_real value);
+
+ private:
+        RK_DISABLE_COPY(RkFilmstrip);
+        RK_DISABLE_MOVE(RkFilmstrip);
+        RK_DELCATE_IMPL_PTR(RkFilmstrip);
+};
+
+#endif // RK_FILMSTRIP_H
@@ -0,0 +1,83 @@
+/**
+ * File name: RkGridContainer.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_GRID_CONTAINER_H
+#define RK_GRID_CONTAINER_H
+
+#include "RkWidget.h"
+#include "RkContainerItem.h"
+
+/**
+ * Places the items in the cells of a grid, an item may span several rows
+ * and columns. The columns are as wide as the size hints of their items,
+ * and the stretched rows and columns share the free space. The items fill
+ * their cells within their minimum and maximum size. Like RkContainer, it
+ * is laid out once per event loop iteration, or by activate().
+ */
+class RK_EXPORT RkGridContainer: public RkContainerItem {
+ public:
+        explicit RkGridContainer(RkWidget *parent);
+        virtual ~RkGridContainer() = default;
+        void addWidget(RkWidget *widget, int row, int column, int rowSpan = 1, int columnSpan = 1);
+        void addContainer(RkContainerItem *container, int row, int column, int rowSpan = 1, int columnSpan = 1);
+        void removeWidget(RkWidget *widget);
+        void clear();
+        int rows() const;
+        int columns() const;
+        void setRowStretch(int row, int stretch);
+        int rowStretch(int row) const;
+        void setColumnStretch(int column, int stretch);
+        int columnStretch(int column) const;
+        void setSpacing(int space);
+        int spacing() const;
+        void setSize(const RkSize &size) override;
+        void setWidth(int width) override;
+        void setHeight(int height) override;
+        void setPosition(const RkPoint &position) override;
+        void setX(int val) override;
+        void setY(int val) override;
+
+ protected:
+        void layout() override;
+
+ private:
+        RK_DISABLE_COPY(RkGridContainer);
+        RK_DISABLE_MOVE(RkGridContainer);
+        struct Cell {
+                RkContainerItem *item;
+                int row;
+                int column;
+                int rowSpan;
+                int columnSpan;
+        };
+        void addCell(RkContainerItem *item, int row, int column, int rowSpan, int columnSpan);
+        void updateGridSize();
+        std::vector<Cell> gridCells;
+        std::vector<int> rowStretches;
+        std::vector<int> columnStretches;
+        int gridRows;
+        int gridColumns;
+        int gridSpacing;
+};
+
+#endif // RK_GRID_CONTAINER_H
@@ -28,12 +28,15 @@
 #include "RkCanvas.h"
 #include "RkSize.h"
 #include "RkColor.h"
+#include "RkRect.h"
 
 class RK_EXPORT RkImage : public RkCanvas {
  public:
         enum class Format : int {
                 ARGB32 = 0,
-                RGB32  = 1
+                RGB32  = 1,
+                // Alpha only, one byte per pixel, used as mask.
+                A8     = 2
         };
 
         RkImage();
@@ -48,40 +51,44 @@ class RK_EXPORT RkImage : public RkCanvas {
 
         virtual ~RkImage();
         RkImage(const RkImage &image);
+        RkImage(RkImage &&image);
         RkImage& operator=(const RkImage &other);
-        friend  bool operator==(const RkImage &im1, const RkImage &im2)
-        {
-                return im1.width() == im2.width()
-                        && im1.height() == im2.height()
-                        && im1.format() == im2.format()
-                        && im1.dataCopy() == im2.dataCopy();
-
-        }
-
-        friend  bool operator!=(const RkImage &im1, const RkImage &im2)
-        {
-                return im1.width() != im2.width()
-                        || im1.height() != im2.height()
-                        || im1.format() != im2.format()
-                        || im1.dataCopy() != im2.dataCopy();
-
-         }
+        RkImage& operator=(RkImage &&other);
+        friend bool operator==(const RkImage &im1, const RkImage &im2);
+        friend bool operator!=(const RkImage &im1, const RkImage &im2);
         void fill(const RkColor &color);
-        const RkCanvasInfo* getCanvasInfo() const;
-        unsigned char* data() const;
+        void fill(const RkColor &color, const RkRect &rect);
+        void applyAlpha(int alpha);
+        // Moves the pixels by dx, dy. The exposed area keeps the old pixels.
+        void scroll(int dx, int dy);
+        const RkCanvasInfo* getCanvasInfo() const override;
+        void beginPaint() override;
+        unsigned char* data();
+        const unsigned char* data() const;
         std::vector<unsigned char> dataCopy() const;
         Format format() const;
         int width() const;
         int height() const;
+        int stride() const;
         RkSize size() const;
         bool isNull() const;
+        /**
+         * Adds a resolution variant of the image for a scale factor, for
+         * example a 2x image (twice the width and height) for HiDPI screens.
+         */
+        void setVariant(double scale, const RkImage &image);
+        /**
+         * Returns the image with the pixels for the scale factor. If there is no
+         * such variant it is resampled once from the closest one and cached.
+         */
+        RkImage variant(double scale) const;
+        bool hasVariants() const;
 
  protected:
         RK_DECLARE_IMPL(RkImage);
+        friend class RkImageRegistry;
+        friend class RkImageAtlas;
         explicit RkImage(std::unique_ptr<RkImageImpl> impl);
-
- private:
-        RK_DISABLE_MOVE(RkImage);
 };
 
 #endif // RK_IMAGE_H
@@ -0,0 +1,56 @@
+/**
+ * File name: RkImageAtlas.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_ATLAS_H
+#define RK_IMAGE_ATLAS_H
+
+#include "RkImageRegion.h"
+
+/**
+ * Packs many small images into one shared image, so that the
+ * skin of a GUI uses a few large surfaces instead of one surface
+ * per image. The images are added at runtime with a shelf packer,
+ * or an existing sprite sheet (e.g. converted with rkpng2c) is used
+ * and its regions are named with setRegion().
+ */
+class RK_EXPORT RkImageAtlas {
+ public:
+        explicit RkImageAtlas(const RkSize &size,
+                              RkImage::Format format = RkImage::Format::ARGB32);
+        explicit RkImageAtlas(const RkImage &sheet);
+        ~RkImageAtlas();
+        RkImageRegion add(const RkImage &image);
+        RkImageRegion add(const std::string &name, const RkImage &image);
+        void setRegion(const std::string &name, const RkRect &rect);
+        RkImageRegion region(const std::string &name) const;
+        RkImageRegion region(const RkRect &rect) const;
+        // A copy of the whole sheet, it doesn't change when images are added.
+        RkImage image() const;
+
+ private:
+        RK_DISABLE_COPY(RkImageAtlas);
+        RK_DISABLE_MOVE(RkImageAtlas);
+        RK_DECLARE_IMPL(RkImageAtlas);
+};
+
+#endif // RK_IMAGE_ATLAS_H
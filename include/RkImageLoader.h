@@ -0,0 +1,78 @@
+/**
+ * File name: RkImageLoader.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_LOADER_H
+#define RK_IMAGE_LOADER_H
+
+#include "Rk.h"
+#include "RkObject.h"
+#include "RkImage.h"
+
+struct RkImageLoadRequest;
+class RkImageLoaderPool;
+
+/**
+ * Loads an image on a background worker pool and delivers it on the
+ * GUI thread through the event queue actions:
+ *
+ *     auto loader = new RkImageLoader(this);
+ *     RK_ACT_BIND(loader, imageLoaded, RK_ACT_ARGS(RkImage image), this, setImage(image));
+ *     loader->load("knob.png", RkImageLoader::Priority::High);
+ *
+ * The images are loaded through RkImageRegistry, so the file and disk
+ * caches are used. Pending requests with higher priority are decoded
+ * first (e.g. visible widgets). Deleting the loader, or its parent,
+ * cancels the request and the action is never called.
+ */
+class RK_EXPORT RkImageLoader: public RkObject {
+ public:
+        enum class Priority : int {
+                Low = 0,
+                Normal = 1,
+                High = 2
+        };
+
+        explicit RkImageLoader(RkObject *parent);
+        virtual ~RkImageLoader();
+        RK_DECL_ACT(imageLoaded, imageLoaded(RkImage image), RK_ARG_TYPE(RkImage), RK_ARG_VAL(image));
+        void load(const std::string &file, Priority priority = Priority::Normal);
+        void load(const unsigned char *resource, Priority priority = Priority::Normal);
+        void setPriority(Priority priority);
+        Priority priority() const;
+        void cancel();
+        bool isLoading() const;
+        const RkImage& image() const;
+        static void setThreads(int n);
+
+ private:
+        RK_DISABLE_COPY(RkImageLoader);
+        RK_DISABLE_MOVE(RkImageLoader);
+        friend class RkImageLoaderPool;
+        void submit(std::shared_ptr<RkImageLoadRequest> request);
+        void finish(const std::shared_ptr<RkImageLoadRequest> &request, const RkImage &image);
+        std::shared_ptr<RkImageLoadRequest> loadRequest;
+        Priority loadPriority;
+        RkImage loadedImage;
+};
+
+#endif // RK_IMAGE_LOADER_H
@@ -0,0 +1,77 @@
+/**
+ * File name: RkImageRegion.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_REGION_H
+#define RK_IMAGE_REGION_H
+
+#include "RkImage.h"
+#include "RkRect.h"
+
+/**
+ * A rectangle of a shared image, usually an RkImageAtlas.
+ * Copying a region is cheap, the image pixels are not copied.
+ * For the atlas regions only the pixels inside the rectangle are
+ * fixed, the atlas adds the next images outside it in place.
+ */
+class RK_EXPORT RkImageRegion {
+ public:
+        RkImageRegion() = default;
+
+        explicit RkImageRegion(const RkImage &image)
+                : regionImage{image}
+                , regionRect{RkPoint(0, 0), image.size()}
+        {
+        }
+
+        RkImageRegion(const RkImage &image, const RkRect &rect)
+                : regionImage{image}
+                , regionRect{rect}
+        {
+        }
+
+        const RkImage& image() const
+        {
+                return regionImage;
+        }
+
+        const RkRect& rect() const
+        {
+                return regionRect;
+        }
+
+        RkSize size() const
+        {
+                return regionRect.size();
+        }
+
+        bool isNull() const
+        {
+                return regionImage.isNull() || regionRect.width() < 1 || regionRect.height() < 1;
+        }
+
+ private:
+        RkImage regionImage;
+        RkRect regionRect;
+};
+
+#endif // RK_IMAGE_REGION_H
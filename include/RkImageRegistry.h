@@ -0,0 +1,95 @@
+/**
+ * File name: RkImageRegistry.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_REGISTRY_H
+#define RK_IMAGE_REGISTRY_H
+
+#include "Rk.h"
+#include "RkImage.h"
+
+/**
+ * Process wide cache of images created from static resource
+ * arrays (RK_IMAGE_RC). Images are keyed by resource pointer and
+ * by content hash, so identical resources are stored only once
+ * even if they come from different arrays.
+ *
+ * The returned images reference the resource data directly and share
+ * the same buffer. The pixels are copied only when an image is
+ * written to (copy-on-write). Entries that are no longer used outside
+ * the registry are evicted by collect().
+ *
+ * Compact resources generated with rkpng2c -c (or packed into one blob
+ * with rkpng2c -d) are decoded lazily, on the first paint or pixel
+ * access, and the decoded pixels are shared by all the returned copies.
+ * The blob images named "<name>@<scale>x" (e.g. knob@2x) are set
+ * as the HiDPI variants of the image "<name>".
+ *
+ * Images loaded from PNG files are kept in a separate LRU cache
+ * bounded by setFileCacheSize(), keyed by the file path and its
+ * modification time. preload() decodes a file on a background thread,
+ * so the first paint doesn't need to wait for the decoder.
+ *
+ * setCacheFile() enables an on-disk cache of the decoded pixels, the
+ * file is mapped at startup and the images use its pages directly,
+ * without decoding. The entries are keyed by the hash of the resource or
+ * of the PNG file content, so changed images are decoded again. The file
+ * is rewritten by syncCacheFile(), RkMain calls it when exec() returns.
+ */
+class RK_EXPORT RkImageRegistry {
+ public:
+        struct Statistics {
+                // The encoded size for the resources not decoded yet.
+                size_t bytesResident = 0;
+                size_t images = 0;
+                size_t hits = 0;
+                size_t misses = 0;
+                double hitRate() const;
+        };
+
+        static RkImage image(const RkSize &size,
+                             const unsigned char *data,
+                             RkImage::Format format = RkImage::Format::ARGB32);
+        static RkImage image(int width,
+                             int height,
+                             const unsigned char *data,
+                             RkImage::Format format = RkImage::Format::ARGB32);
+        static RkImage image(const unsigned char *resource);
+        // The size is the size of the blob array, e.g. sizeof(array).
+        static RkImage image(const unsigned char *blob, size_t size, const std::string &name);
+        static RkImage image(const std::string &file);
+        static void preload(const std::string &file);
+        static bool setCacheFile(const std::string &file);
+        static bool syncCacheFile();
+        static void setFileCacheSize(size_t bytes);
+        static size_t fileCacheSize();
+        static size_t collect();
+        static Statistics statistics();
+
+ private:
+        RkImageRegistry() = delete;
+        static RkImage loadImage(const std::string &file);
+        // Must be called with the registry locked.
+        static RkImage& resourceImage(const unsigned char *resource, bool &created);
+};
+
+#endif // RK_IMAGE_REGISTRY_H
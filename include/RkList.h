@@ -29,13 +29,32 @@
 
 class RkModel;
 
+/**
+ * List of the model items. Only the visible items are fetched from
+ * the model and drawn, so the paint time doesn't depend on the model size.
+ */
 class RK_EXPORT RkList : public RkWidget {
  public:
         RkList(RkWidget *parent, RkModel *model = nullptr);
         virtual ~RkList() = default;
         RkModel* getModel() const;
+        // Scroll offset in pixels from the top of the first item.
+        int scrollOffset() const;
+        void setScrollOffset(int offset);
+        int maxScrollOffset() const;
+        // Scrolls the minimum needed to make the item visible.
+        void scrollToItem(size_t index);
+        // Index of the item at the y coordinate, -1 if there is none.
+        size_t itemAt(int y) const;
+        RK_DECL_ACT(scrollOffsetChanged,
+                    scrollOffsetChanged(int offset),
+                    RK_ARG_TYPE(int),
+                    RK_ARG_VAL(offset));
 
  protected:
+        void onItemsChanged(size_t first, size_t last);
+        void onItemsInserted(size_t first, size_t last);
+        void onItemsRemoved(size_t first, size_t last);
         virtual void paintEvent(RkPaintEvent *event) override;
         virtual void keyPressEvent(RkKeyEvent *event) override;
         virtual void keyReleaseEvent(RkKeyEvent *event) override;
@@ -28,6 +28,8 @@
 #include "RkObject.h"
 #include "RkVariant.h"
 
+#include <string_view>
+
 class RK_EXPORT RkModel;
 
 class RK_EXPORT RkModelItem {
@@ -55,21 +57,80 @@ class RK_EXPORT RkModelItem {
         size_t itemIndex;
 };
 
+/**
+ * Data of one item filled by RkModel::itemsData(). The text and the font
+ * point into the model storage and are valid until the model changes.
+ * The storage members are used when the model doesn't keep the data, the
+ * rows can be reused between calls to avoid allocations.
+ */
+struct RK_EXPORT RkModelRow {
+        std::string_view text;
+        bool hasColor = false;
+        RkColor color;
+        const RkFont *font = nullptr;
+        std::string textStorage;
+        RkFont fontStorage;
+};
+
+/**
+ * Models notify the views about changes with the range actions, the ranges
+ * are [first, last]. modelChanged means that anything may have changed and
+ * the views fetch everything again. Changes made between beginUpdate() and
+ * endUpdate() are merged into one notification.
+ */
 class RK_EXPORT RkModel: public RkObject {
   public:
         explicit RkModel(RkObject *parent);
         virtual ~RkModel() = default;
         RK_DECL_ACT(modelChanged, modelChanged(), RK_ARG_TYPE(), RK_ARG_VAL());
         RK_DECL_ACT(itemSelected, itemSelected(RkModelItem item), RK_ARG_TYPE(RkModelItem), RK_ARG_VAL(item));
+        RK_DECL_ACT(itemsInserted,
+                    itemsInserted(size_t first, size_t last),
+                    RK_ARG_TYPE(size_t, size_t),
+                    RK_ARG_VAL(first, last));
+        RK_DECL_ACT(itemsRemoved,
+                    itemsRemoved(size_t first, size_t last),
+                    RK_ARG_TYPE(size_t, size_t),
+                    RK_ARG_VAL(first, last));
+        // The role is the changed data type, or -1 for all data types.
+        RK_DECL_ACT(itemsChanged,
+                    itemsChanged(size_t first, size_t last, int role),
+                    RK_ARG_TYPE(size_t, size_t, int),
+                    RK_ARG_VAL(first, last, role));
         virtual RkVariant itemData(size_t index, int dataType = static_cast<int>(RkModelItem::DataType::String)) const = 0;
         virtual size_t itemsNumber() const = 0;
         virtual int itemSpan() const = 0;
+        static constexpr int dataTypeMask(RkModelItem::DataType type)
+        {
+                return 1 << static_cast<int>(type);
+        }
+        /**
+         * Fills the rows for count items from first, for the data types in
+         * the mask (see dataTypeMask()). The default implementation calls
+         * itemData() for each item and data type. Models that keep the data
+         * can override it to fill the rows without copying.
+         */
+        virtual void itemsData(size_t first, size_t count, int dataTypes, RkModelRow *rows) const;
+        /**
+         * Fills only the text of the rows with the string data of the
+         * dataType, which can be any role like UserType + n. The default
+         * implementation calls itemData() for each item.
+         */
+        virtual void itemsText(size_t first, size_t count, int dataType, RkModelRow *rows) const;
         void selectItem(size_t index);
         bool isItemSelected(size_t index) const;
         bool isValidIndex(size_t index) const;
+        void beginUpdate();
+        void endUpdate();
+        bool isUpdating() const;
 
  protected:
+        // Called by the models after their data was changed.
+        void notifyItemsInserted(size_t first, size_t last);
+        void notifyItemsRemoved(size_t first, size_t last);
+        void notifyItemsChanged(size_t first, size_t last, int role = -1);
         RK_DELCATE_IMPL_PTR(RkModel);
+        explicit RkModel(RkObject *parent, std::unique_ptr<RkModelImpl> impl);
 
  private:
         RK_DISABLE_COPY(RkModel);
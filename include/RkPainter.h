@@ -26,10 +26,15 @@
 
 #include "Rk.h"
 #include "RkImage.h"
+#include "RkImageRegion.h"
 #include "RkPoint.h"
 #include "RkPen.h"
 #include "RkRect.h"
 #include "RkFont.h"
+#include "RkPicture.h"
+#include "RkPath.h"
+
+#include <string_view>
 
 class RkCanvas;
 
@@ -37,19 +42,44 @@ class RK_EXPORT RkPainter {
  public:
         RkPainter(RkCanvas *canvas);
         ~RkPainter();
-        void drawText(int x, int y, const std::string &text);
-        void drawText(const RkPoint &p,  const std::string &text);
+        // The text doesn't have to be NUL-terminated.
+        void drawText(int x, int y, std::string_view text);
+        void drawText(const RkPoint &p, std::string_view text);
         void drawText(const RkRect &rect,
-                      const std::string &text,
+                      std::string_view text,
                       Rk::Alignment alignment = Rk::Alignment::AlignCenter);
         void drawImage(const RkImage &image, int x, int y);
+        void drawImage(const std::string &file, int x, int y);
+        void drawImage(const RkImageRegion &region, int x, int y);
+        void drawMask(const RkImage &mask, int x, int y);
+        void drawMask(const RkImage &mask, int x, int y, const RkColor &color);
         void drawCircle(int x, int y, int radius);
         void drawCircle(const RkPoint &p, int radius);
         void drawLine(int x1, int y1, int x2, int y2);
         void drawLine(const RkPoint &p1, const RkPoint &p2);
         void drawRect(const RkRect &rect);
         void drawPolyline(const std::vector<RkPoint> &points);
+        // Strokes the path with the pen.
+        void drawPath(const RkPath &path);
+        // Fills the path with the pen color, or with the given color.
+        void fillPath(const RkPath &path);
+        void fillPath(const RkPath &path, const RkColor &color);
         void fillRect(const RkRect &rect, const RkColor &color);
+        /**
+         * Batched drawing, one stroke or fill per color instead of one per item.
+         * The colors are given per item. Items are grouped by color, so the order
+         * of overlapping items with different colors is not kept.
+         */
+        // Draws a line between each pair of points.
+        void drawLines(const std::vector<RkPoint> &points);
+        void drawLines(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
+        void drawRects(const std::vector<RkRect> &rects);
+        void drawRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void fillRects(const std::vector<RkRect> &rects, const RkColor &color);
+        void fillRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        // Draws squares of the pen width.
+        void drawPoints(const std::vector<RkPoint> &points);
+        void drawPoints(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
         void applyAlpha(int alpha);
         const RkPen& pen() const;
         void setPen(const RkPen &pen);
@@ -57,7 +87,21 @@ class RK_EXPORT RkPainter {
         void setFont(const RkFont &font);
         void translate(const RkPoint &offset);
         void rotate(rk_real angle);
-        int getTextWidth(const std::string &text) const;
+        // Saves the pen, font, transformation and clip, restore() brings them back.
+        void save();
+        void restore();
+        /**
+         * Intersects the clip with the rectangle, or with the union of the
+         * rectangles for a region. Use save() and restore() to undo it.
+         */
+        void setClipRect(const RkRect &rect);
+        void setClipRegion(const std::vector<RkRect> &rects);
+        // Bounds of the visible area in the current coordinates.
+        RkRect clipBounds() const;
+        int getTextWidth(std::string_view text) const;
+        void drawPicture(const RkPicture &picture, int x = 0, int y = 0);
+        // Draws the source part of the picture with its top-left corner at (x, y).
+        void drawPicture(const RkPicture &picture, const RkRect &source, int x, int y);
 
  private:
         RK_DISABLE_COPY(RkPainter);
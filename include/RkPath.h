@@ -0,0 +1,79 @@
+/**
+ * File name: RkPath.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PATH_H
+#define RK_PATH_H
+
+#include "Rk.h"
+#include "RkRealPoint.h"
+#include "RkRect.h"
+
+/**
+ * RkPath is a reusable shape drawn with RkPainter::drawPath() and
+ * RkPainter::fillPath(). The graphics backend converts the path to its own
+ * format once and caches it, so a static shape isn't rebuilt on every paint.
+ * Copies share the elements and the cache.
+ */
+class RK_EXPORT RkPath {
+ public:
+        enum class Element : int {
+                MoveTo  = 0,
+                LineTo  = 1,
+                CurveTo = 2,
+                ArcTo   = 3,
+                Close   = 4
+        };
+
+        RkPath();
+        ~RkPath();
+        RkPath(const RkPath &path);
+        RkPath(RkPath &&path);
+        RkPath& operator=(const RkPath &other);
+        RkPath& operator=(RkPath &&other);
+        friend bool operator==(const RkPath &path1, const RkPath &path2);
+        friend bool operator!=(const RkPath &path1, const RkPath &path2);
+        void moveTo(const RkRealPoint &p);
+        void lineTo(const RkRealPoint &p);
+        // Cubic Bezier curve from the current point to p.
+        void curveTo(const RkRealPoint &c1, const RkRealPoint &c2, const RkRealPoint &p);
+        /**
+         * Arc of the circle with the center and radius, angles in radians.
+         * The arc goes clockwise if endAngle > startAngle, otherwise
+         * counterclockwise. A line joins the current point to the arc start.
+         */
+        void arcTo(const RkRealPoint &center, rk_real radius, rk_real startAngle, rk_real endAngle);
+        void close();
+        void addRect(const RkRect &rect);
+        void addRoundedRect(const RkRect &rect, rk_real radius);
+        void clear();
+        bool isEmpty() const;
+        // Bounds of all points of the path, including the control points.
+        RkRect boundingRect() const;
+        size_t hash() const;
+
+ protected:
+        RK_DECLARE_IMPL(RkPath);
+        friend class RkCairoGraphicsBackend;
+};
+
+#endif // RK_PATH_H
@@ -0,0 +1,60 @@
+/**
+ * File name: RkPicture.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PICTURE_H
+#define RK_PICTURE_H
+
+#include "RkCanvas.h"
+
+/**
+ * RkPicture records the drawing done by RkPainter instead of rasterizing it.
+ * The recorded commands can be replayed later with RkPainter::drawPicture()
+ * on any canvas, and two pictures can be compared to find out if anything
+ * changed since the last paint. Copies share the recorded commands.
+ */
+class RK_EXPORT RkPicture : public RkCanvas {
+ public:
+        RkPicture();
+        virtual ~RkPicture();
+        RkPicture(const RkPicture &picture);
+        RkPicture(RkPicture &&picture);
+        RkPicture& operator=(const RkPicture &other);
+        RkPicture& operator=(RkPicture &&other);
+        friend bool operator==(const RkPicture &pic1, const RkPicture &pic2);
+        friend bool operator!=(const RkPicture &pic1, const RkPicture &pic2);
+        // Pictures have no pixels, returns nullptr.
+        const RkCanvasInfo* getCanvasInfo() const override;
+        void beginPaint() override;
+        void clear();
+        bool isEmpty() const;
+        // Size of the recorded commands in bytes.
+        size_t size() const;
+        // Hash of the recorded commands, equal pictures have the same hash.
+        size_t hash() const;
+
+ protected:
+        RK_DECLARE_IMPL(RkPicture);
+        friend class RkPainter;
+};
+
+#endif // RK_PICTURE_H
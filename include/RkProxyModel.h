@@ -0,0 +1,74 @@
+/**
+ * File name: RkProxyModel.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PROXY_MODEL_H
+#define RK_PROXY_MODEL_H
+
+#include "RkModel.h"
+
+/**
+ * Filters and sorts the items of a source model by their string data
+ * without copying the model. The proxy keeps a mapping of its items to
+ * the source items and follows the changes of the source model.
+ *
+ * The filter matches case-insensitive substrings. Extending the filter
+ * only refines the current items, and the sorted order of the source is
+ * kept between filter changes, so typing a query doesn't sort again.
+ */
+class RK_EXPORT RkProxyModel: public RkModel {
+ public:
+        enum class SortOrder : int {
+                None       = 0,
+                Ascending  = 1,
+                Descending = 2
+        };
+
+        RkProxyModel(RkObject *parent, RkModel *source);
+        virtual ~RkProxyModel() = default;
+        RkModel* sourceModel() const;
+        void setFilter(const std::string &text);
+        std::string filter() const;
+        void setSortOrder(SortOrder order);
+        SortOrder sortOrder() const;
+        // Returns size_t(-1) if there is no such item.
+        size_t mapToSource(size_t index) const;
+        size_t mapFromSource(size_t sourceIndex) const;
+        RkVariant itemData(size_t index, int dataType = static_cast<int>(RkModelItem::DataType::String)) const override;
+        size_t itemsNumber() const override;
+        int itemSpan() const override;
+        void itemsData(size_t first, size_t count, int dataTypes, RkModelRow *rows) const override;
+        void itemsText(size_t first, size_t count, int dataType, RkModelRow *rows) const override;
+
+ protected:
+        RK_DELCATE_IMPL_PTR(RkProxyModel);
+
+ private:
+        RK_DISABLE_COPY(RkProxyModel);
+        RK_DISABLE_MOVE(RkProxyModel);
+        void onSourceModelChanged();
+        void onSourceItemsInserted(size_t first, size_t last);
+        void onSourceItemsRemoved(size_t first, size_t last);
+        void onSourceItemsChanged(size_t first, size_t last, int role);
+};
+
+#endif // RK_PROXY_MODEL_H
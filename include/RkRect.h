@@ -166,6 +166,41 @@ class RK_EXPORT RkRect {
                 return width() * height();
         }
 
+        constexpr bool contains(const RkPoint &point) const
+        {
+                return left() <= point.x() && point.x() < right()
+                        && top() <= point.y() && point.y() < bottom();
+        }
+
+        constexpr bool intersects(const RkRect &rect) const
+        {
+                return left() < rect.right() && rect.left() < right()
+                        && top() < rect.bottom() && rect.top() < bottom();
+        }
+
+        constexpr RkRect intersected(const RkRect &rect) const
+        {
+                if (!intersects(rect))
+                        return RkRect();
+                return RkRect(RkPoint(left() > rect.left() ? left() : rect.left(),
+                                      top() > rect.top() ? top() : rect.top()),
+                              RkPoint(right() < rect.right() ? right() : rect.right(),
+                                      bottom() < rect.bottom() ? bottom() : rect.bottom()));
+        }
+
+        // Bounding rectangle of both, empty rectangles are ignored.
+        constexpr RkRect united(const RkRect &rect) const
+        {
+                if (rect.area() == 0)
+                        return *this;
+                if (area() == 0)
+                        return rect;
+                return RkRect(RkPoint(left() < rect.left() ? left() : rect.left(),
+                                      top() < rect.top() ? top() : rect.top()),
+                              RkPoint(right() > rect.right() ? right() : rect.right(),
+                                      bottom() > rect.bottom() ? bottom() : rect.bottom()));
+        }
+
  private:
        RkPoint rectTopLeft;
        RkPoint rectBottomRight;
@@ -0,0 +1,81 @@
+/**
+ * File name: RkScrollArea.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_SCROLL_AREA_H
+#define RK_SCROLL_AREA_H
+
+#include "RkWidget.h"
+
+class RkPainter;
+
+/**
+ * Shows a part of a content bigger than the widget. The content is drawn
+ * by paintContent() into tiles that are cached, and the visible part is
+ * composed from the tiles into a buffer. Scrolling moves the pixels in
+ * the buffer and composes only the exposed strip, so a tile is drawn
+ * once until updateContent() invalidates it.
+ *
+ *     class Timeline: public RkScrollArea {
+ *             void paintContent(RkPainter &painter, const RkRect &rect) override
+ *             {
+ *                     // Draw the content inside rect, in content coordinates.
+ *             }
+ *     };
+ */
+class RK_EXPORT RkScrollArea : public RkWidget {
+ public:
+        explicit RkScrollArea(RkWidget *parent);
+        virtual ~RkScrollArea() = default;
+        void setContentSize(const RkSize &size);
+        const RkSize& contentSize() const;
+        void setScrollPosition(const RkPoint &position);
+        const RkPoint& scrollPosition() const;
+        void scrollBy(int dx, int dy);
+        RkPoint maxScrollPosition() const;
+        // Invalidates the cached content in the rectangle, in content coordinates.
+        void updateContent(const RkRect &rect);
+        void updateContent();
+        void setTileSize(int size);
+        int tileSize() const;
+        // The least recently used tiles above the limit are dropped.
+        void setTilesLimit(size_t limit);
+        size_t tilesLimit() const;
+        RK_DECL_ACT(scrollPositionChanged,
+                    scrollPositionChanged(RkPoint position),
+                    RK_ARG_TYPE(RkPoint),
+                    RK_ARG_VAL(position));
+
+ protected:
+        // Draws the content in the rectangle, the painter uses content coordinates.
+        virtual void paintContent(RkPainter &painter, const RkRect &rect);
+        virtual void paintEvent(RkPaintEvent *event) override;
+        virtual void resizeEvent(RkResizeEvent *event) override;
+        virtual void mouseButtonPressEvent(RkMouseEvent *event) override;
+
+ private:
+        RK_DISABLE_COPY(RkScrollArea);
+        RK_DISABLE_MOVE(RkScrollArea);
+        RK_DELCATE_IMPL_PTR(RkScrollArea);
+};
+
+#endif // RK_SCROLL_AREA_H
@@ -0,0 +1,93 @@
+/**
+ * File name: RkTableView.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_TABLE_VIEW_H
+#define RK_TABLE_VIEW_H
+
+#include "RkWidget.h"
+#include "RkModel.h"
+
+/**
+ * Table of the model items, one item per row. Each column shows the data
+ * of a data type of the items, for example RkModelItem::DataType::UserType
+ * plus the column number. Only the visible cells are fetched and drawn.
+ *
+ * The rows are drawn into a buffer that is moved when scrolling, so only
+ * the exposed strip is drawn. The header stays at the top.
+ */
+class RK_EXPORT RkTableView : public RkWidget {
+ public:
+        RkTableView(RkWidget *parent, RkModel *model = nullptr);
+        virtual ~RkTableView() = default;
+        RkModel* getModel() const;
+        // Returns the index of the column.
+        size_t addColumn(const std::string &title,
+                         int width,
+                         int dataType = static_cast<int>(RkModelItem::DataType::String));
+        size_t columnsNumber() const;
+        std::string columnTitle(size_t column) const;
+        void setColumnWidth(size_t column, int width);
+        int columnWidth(size_t column) const;
+        // Resizable columns can be resized with the mouse in the header.
+        void setColumnResizable(size_t column, bool resizable);
+        bool isColumnResizable(size_t column) const;
+        // Fits the column to the title and the visible cells.
+        void resizeColumnToContents(size_t column);
+        void setHeaderHeight(int height);
+        int headerHeight() const;
+        int scrollOffset() const;
+        void setScrollOffset(int offset);
+        int maxScrollOffset() const;
+        int horizontalScrollOffset() const;
+        void setHorizontalScrollOffset(int offset);
+        int maxHorizontalScrollOffset() const;
+        void scrollToItem(size_t index);
+        // Return -1 if there is no item or column at the coordinate.
+        size_t itemAt(int y) const;
+        size_t columnAt(int x) const;
+        RK_DECL_ACT(scrollOffsetChanged,
+                    scrollOffsetChanged(int offset),
+                    RK_ARG_TYPE(int),
+                    RK_ARG_VAL(offset));
+        RK_DECL_ACT(columnResized,
+                    columnResized(size_t column, int width),
+                    RK_ARG_TYPE(size_t, int),
+                    RK_ARG_VAL(column, width));
+
+ protected:
+        void onModelChanged();
+        void onItemsChanged(size_t first, size_t last);
+        void onItemsInserted(size_t first, size_t last);
+        void onItemsRemoved(size_t first, size_t last);
+        virtual void paintEvent(RkPaintEvent *event) override;
+        virtual void mouseMoveEvent(RkMouseEvent *event) override;
+        virtual void mouseButtonPressEvent(RkMouseEvent *event) override;
+        virtual void mouseButtonReleaseEvent(RkMouseEvent *event) override;
+
+ private:
+        RK_DISABLE_COPY(RkTableView);
+        RK_DISABLE_MOVE(RkTableView);
+        RK_DELCATE_IMPL_PTR(RkTableView);
+};
+
+#endif // RK_TABLE_VIEW_H
@@ -0,0 +1,100 @@
+/**
+ * File name: RkTreeModel.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_TREE_MODEL_H
+#define RK_TREE_MODEL_H
+
+#include "Rk.h"
+#include "RkObject.h"
+#include "RkVariant.h"
+#include "RkModel.h"
+
+#include <functional>
+
+/**
+ * Hierarchical model. The nodes are identified by ids chosen by the model
+ * (an index or a pointer), that must not change while the node exists.
+ * The root node is the invisible parent of the top level nodes.
+ *
+ * The children can be loaded lazily: the views call fetchMore() when
+ * a node with canFetchMore() is expanded, and the model notifies the
+ * loaded children with childrenInserted. fetchAsync() runs the loading
+ * on the threads shared by the models:
+ *
+ *     void fetchMore(NodeId parent) override
+ *     {
+ *             auto files = std::make_shared<std::vector<std::string>>();
+ *             fetchAsync([files, path = path(parent)] { *files = listDirectory(path); },
+ *                        [this, parent, files] { addChildren(parent, std::move(*files)); });
+ *     }
+ */
+class RK_EXPORT RkTreeModel: public RkObject {
+ public:
+        using NodeId = uintptr_t;
+        static constexpr NodeId rootNode = 0;
+
+        explicit RkTreeModel(RkObject *parent);
+        virtual ~RkTreeModel();
+        RK_DECL_ACT(modelChanged, modelChanged(), RK_ARG_TYPE(), RK_ARG_VAL());
+        // The children ranges are [first, last].
+        RK_DECL_ACT(childrenInserted,
+                    childrenInserted(NodeId parent, size_t first, size_t last),
+                    RK_ARG_TYPE(NodeId, size_t, size_t),
+                    RK_ARG_VAL(parent, first, last));
+        RK_DECL_ACT(childrenRemoved,
+                    childrenRemoved(NodeId parent, size_t first, size_t last),
+                    RK_ARG_TYPE(NodeId, size_t, size_t),
+                    RK_ARG_VAL(parent, first, last));
+        RK_DECL_ACT(nodeChanged, nodeChanged(NodeId node), RK_ARG_TYPE(NodeId), RK_ARG_VAL(node));
+        // The number of the loaded children.
+        virtual size_t childrenNumber(NodeId parent) const = 0;
+        virtual NodeId child(NodeId parent, size_t index) const = 0;
+        virtual RkVariant nodeData(NodeId node,
+                                   int dataType = static_cast<int>(RkModelItem::DataType::String)) const = 0;
+        virtual int itemSpan() const = 0;
+        // Returns true if the node has children, loaded or not.
+        virtual bool hasChildren(NodeId node) const;
+        virtual bool canFetchMore(NodeId parent) const;
+        virtual void fetchMore(NodeId parent);
+
+ protected:
+        // Called by the models after the children were changed.
+        void notifyChildrenInserted(NodeId parent, size_t first, size_t last);
+        void notifyChildrenRemoved(NodeId parent, size_t first, size_t last);
+        void notifyNodeChanged(NodeId node);
+        /**
+         * Calls load on a worker thread of the shared fetch pool and then
+         * finish on the GUI thread. The load function must not use the model.
+         * If the model is deleted before, the pending load is dropped and
+         * finish is not called. Without an event queue both are called on
+         * the calling thread.
+         */
+        void fetchAsync(std::function<void()> load, std::function<void()> finish);
+        RK_DELCATE_IMPL_PTR(RkTreeModel);
+
+ private:
+        RK_DISABLE_COPY(RkTreeModel);
+        RK_DISABLE_MOVE(RkTreeModel);
+};
+
+#endif // RK_TREE_MODEL_H
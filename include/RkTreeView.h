@@ -0,0 +1,80 @@
+/**
+ * File name: RkTreeView.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_TREE_VIEW_H
+#define RK_TREE_VIEW_H
+
+#include "RkWidget.h"
+#include "RkTreeModel.h"
+
+/**
+ * Tree of the model nodes. The view keeps the rows of the expanded nodes
+ * only, updated in place when a node is expanded or collapsed, and draws
+ * the visible rows. Expanding a node that can fetch more children calls
+ * RkTreeModel::fetchMore(), the children are added when the model
+ * notifies them.
+ */
+class RK_EXPORT RkTreeView : public RkWidget {
+ public:
+        using NodeId = RkTreeModel::NodeId;
+
+        RkTreeView(RkWidget *parent, RkTreeModel *model);
+        virtual ~RkTreeView() = default;
+        RkTreeModel* getModel() const;
+        void expand(NodeId node);
+        void collapse(NodeId node);
+        bool isExpanded(NodeId node) const;
+        void setIndentation(int indentation);
+        int indentation() const;
+        size_t rowsNumber() const;
+        // Returns RkTreeModel::rootNode if there is no such row.
+        NodeId nodeAt(int y) const;
+        NodeId selectedNode() const;
+        void selectNode(NodeId node);
+        int scrollOffset() const;
+        void setScrollOffset(int offset);
+        int maxScrollOffset() const;
+        RK_DECL_ACT(nodeSelected, nodeSelected(NodeId node), RK_ARG_TYPE(NodeId), RK_ARG_VAL(node));
+        RK_DECL_ACT(nodeExpanded, nodeExpanded(NodeId node), RK_ARG_TYPE(NodeId), RK_ARG_VAL(node));
+        RK_DECL_ACT(nodeCollapsed, nodeCollapsed(NodeId node), RK_ARG_TYPE(NodeId), RK_ARG_VAL(node));
+        RK_DECL_ACT(scrollOffsetChanged,
+                    scrollOffsetChanged(int offset),
+                    RK_ARG_TYPE(int),
+                    RK_ARG_VAL(offset));
+
+ protected:
+        void onModelChanged();
+        void onChildrenInserted(NodeId parent, size_t first, size_t last);
+        void onChildrenRemoved(NodeId parent, size_t first, size_t last);
+        void onNodeChanged(NodeId node);
+        virtual void paintEvent(RkPaintEvent *event) override;
+        virtual void mouseButtonPressEvent(RkMouseEvent *event) override;
+        virtual void mouseDoubleClickEvent(RkMouseEvent *event) override;
+
+ private:
+        RK_DISABLE_COPY(RkTreeView);
+        RK_DISABLE_MOVE(RkTreeView);
+        RK_DELCATE_IMPL_PTR(RkTreeView);
+};
+
+#endif // RK_TREE_VIEW_H
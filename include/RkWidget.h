@@ -124,6 +124,10 @@ class RK_EXPORT RkWidget: public RkObject, public RkCanvas {
           bool isInputEnabled() const;
           RkWidget* getTopWidget();
           bool isTopWindow() const;
+          // The topmost shown widget at the point, this one or a child, in this widget coordinates.
+          RkWidget* widgetAt(const RkPoint &point);
+          // The shown widgets intersecting the rectangle, from the bottom to the top.
+          std::vector<RkWidget*> widgetsIn(const RkRect &rect);
           void enableGrabKey(bool b);
           bool grabKeyEnabled() const;
           void propagateGrabKey(bool b);
@@ -35,7 +35,7 @@ class RkButton::RkButtonImpl : public RkWidget::RkWidgetImpl {
         virtual ~RkButtonImpl() = default;
         void setText(const RkString &text);
         RkString text() const;
-        void setImage(const RkImage &img, RkButton::State type);
+        void setImage(const RkImageRegion &region, RkButton::State type);
         bool isPressed() const;
         void setPressed(bool pressed);
         ButtonType type() const;
@@ -51,7 +51,7 @@ class RkButton::RkButtonImpl : public RkWidget::RkWidgetImpl {
         RK_DECALRE_INTERFACE_PTR(RkButton);
         ButtonType buttonType;
         bool is_pressed;
-        std::array<RkImage, 4> buttonImages;
+        std::array<RkImageRegion, 4> buttonImages;
         RkButton::State buttonState;
         bool isEmphasizeEnabled;
         RkString buttonText;
@@ -30,35 +30,64 @@
 #include "RkPen.h"
 #include "RkRect.h"
 #include "RkFont.h"
+#include "RkPath.h"
 
 #include <cairo/cairo.h>
 
+#include <string_view>
+
 class RkCanvas;
 
 class RkCairoGraphicsBackend {
  public:
         RkCairoGraphicsBackend(RkCanvas* canvas);
+        RkCairoGraphicsBackend();
         ~RkCairoGraphicsBackend();
         void drawText(const std::string &text, int x, int y);
-        void drawImage(const std::string &file, int x, int y);
+        void drawText(std::string_view text, int x, int y);
         void drawImage(const RkImage &image, int x, int y);
+        void drawImage(const RkImage &image, const RkRect &source, int x, int y);
+        void drawMask(const RkImage &mask, int x, int y, const RkColor &color);
         void drawEllipse(const RkPoint& p, int width, int height);
         void drawLine(const RkPoint &p1, const RkPoint &p2);
         void drawRect(const RkRect &rect);
         void drawPolyLine(const std::vector<RkPoint> &points);
+        void drawPath(const RkPath &path);
+        void fillPath(const RkPath &path, const RkColor &color);
         void fillRect(const RkRect &rect, const RkColor &color);
+        // Colors for the batched calls: none for the pen color, one for all items or one per item.
+        void drawLines(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
+        void drawRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void fillRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void drawPoints(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
         void applyAlpha(int alpha);
         void setPen(const RkPen &pen);
         void setFont(const RkFont &font);
         int getTextWidth(const std::string &text) const;
+        int getTextWidth(std::string_view text) const;
         void translate(const RkPoint &offset);
         void rotate(rk_real angle);
+        void save();
+        void restore();
+        // Intersects the clip with the union of the rectangles.
+        void clip(const std::vector<RkRect> &rects);
+        RkRect clipBounds() const;
 
  protected:
         cairo_t* context() const;
+        const char* terminated(std::string_view text) const;
+        cairo_pattern_t* imagePattern(const RkImage &image, const RkImage &variant, int x, int y) const;
+        template<class Paint>
+        void paintImage(const RkImage &image, int x, int y, Paint paint);
+        void appendPath(const RkPath &path);
+        template<class AddItem>
+        void drawBuckets(size_t n, const std::vector<RkColor> &colors, AddItem addItem, bool fill);
 
  private:
         cairo_t* cairoContext;
+        double deviceScale;
+        // Reused for the NUL-terminated copies of string views passed to Cairo.
+        mutable std::string textBuffer;
 };
 
 #endif // RK_CAIRO_GRAPHICS_BACKEND_H
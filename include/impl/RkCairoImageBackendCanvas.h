@@ -28,27 +28,54 @@
 
 #include <cairo/cairo.h>
 
+#include <atomic>
+#include <mutex>
+
 class RkCairoImageBackendCanvas {
  public:
         RkCairoImageBackendCanvas(const RkSize &size,
                                   RkImage::Format format,
-                                  const unsigned char *data);
+                                  const unsigned char *data,
+                                  bool borrowData = false,
+                                  int dataStride = 0);
+        explicit RkCairoImageBackendCanvas(const std::string &file);
+        // Compact rkpng2c resource, decoded on the first pixel access.
+        explicit RkCairoImageBackendCanvas(const unsigned char *resource);
+        RkCairoImageBackendCanvas(const RkCairoImageBackendCanvas &other);
         ~RkCairoImageBackendCanvas();
         const RkSize& size() const;
+        int stride() const;
         bool isNull() const;
+        bool isBorrowed() const;
+        // False for a resource that was not decoded yet.
+        bool isDecoded() const;
         unsigned char* data();
+        const unsigned char* data() const;
         std::vector<unsigned char> dataCopy() const;
         RkCanvasInfo *getCanvasInfo() const;
         void fill(const RkColor &color);
+        void fill(const RkColor &color, const RkRect &rect);
+        void applyAlpha(int alpha);
+        void scroll(int dx, int dy);
+        void paste(const RkCairoImageBackendCanvas &image, int x, int y);
 
  protected:
         cairo_format_t toCairoFormat(RkImage::Format format) const;
         int pixelLength(RkImage::Format format) const;
+        void decode() const;
+        void createSurface(unsigned char *pixels) const;
 
  private:
-        std::unique_ptr<RkCanvasInfo> canvasInfo;
-        std::vector<unsigned char> imageData;
+        mutable std::unique_ptr<RkCanvasInfo> canvasInfo;
+        mutable std::vector<unsigned char> imageData;
+        // Pixels owned by someone else (e.g. a const resource array), never written.
+        const unsigned char *borrowedData;
         RkSize imageSize;
+        RkImage::Format imageFormat;
+        int imageStride;
+        const unsigned char *encodedData;
+        mutable std::once_flag decodeFlag;
+        mutable std::atomic<bool> decodeDone{false};
 };
 
 #endif // RK_CAIRO_IMAGE_BACKEND_CANVAS_H
@@ -0,0 +1,77 @@
+/**
+ * File name: RkFilmstripImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_FILMSTRIP_IMPL_H
+#define RK_FILMSTRIP_IMPL_H
+
+#include "RkWidgetImpl.h"
+#include "RkFilmstrip.h"
+
+#include <atomic>
+
+class RkPainter;
+
+class RkFilmstrip::RkFilmstripImpl : public RkWidget::RkWidgetImpl {
+ public:
+        RkFilmstripImpl(RkFilmstrip *interface, RkWidget *parent = nullptr);
+        virtual ~RkFilmstripImpl() = default;
+        void setImage(const RkImageRegion &strip, int frames, Rk::Orientation orientation);
+        RkSize frameSize() const;
+        int frames() const;
+        int frame() const;
+        void setRange(rk_real begin, rk_real end);
+        rk_real beginValue() const;
+        rk_real endValue() const;
+        rk_real value() const;
+        // Returns true if an update needs to be posted to the GUI thread.
+        bool setValue(rk_real value);
+        // Called by the GUI thread, returns true if the frame changed.
+        bool syncFrame();
+        void setDragDistance(int distance);
+        int dragDistance() const;
+        void startDrag(int y);
+        void stopDrag();
+        bool isDragging() const;
+        rk_real dragValue(int y) const;
+        void drawFrame(RkPainter &painter);
+
+ protected:
+        int frameFromValue(rk_real value) const;
+
+ private:
+        RK_DECALRE_INTERFACE_PTR(RkFilmstrip);
+        RkImageRegion stripRegion;
+        int framesNumber;
+        Rk::Orientation stripOrientation;
+        std::atomic<rk_real> beginVal;
+        std::atomic<rk_real> endVal;
+        std::atomic<rk_real> currentValue;
+        std::atomic<bool> updatePending;
+        int currentFrame;
+        int dragPixels;
+        bool isDrag;
+        int dragStartY;
+        rk_real dragStartValue;
+};
+
+#endif // RK_FILMSTRIP_IMPL_H
@@ -0,0 +1,60 @@
+/**
+ * File name: RkImageAtlasImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_ATLAS_IMPL_H
+#define RK_IMAGE_ATLAS_IMPL_H
+
+#include "RkImageAtlas.h"
+
+#include <unordered_map>
+
+class RkImageAtlas::RkImageAtlasImpl {
+ public:
+        RkImageAtlasImpl(RkImageAtlas *interface, const RkImage &image);
+        ~RkImageAtlasImpl();
+        // Returns false if there is no space left for the size.
+        bool allocate(const RkSize &size, RkRect &rect);
+        void setRegion(const std::string &name, const RkRect &rect);
+        RkRect region(const std::string &name) const;
+        RkImage& image();
+        void setImageShared();
+        // Returns true if the image was shared since the last call.
+        bool takeImageShared();
+
+ private:
+        struct Shelf {
+                int y;
+                int height;
+                int width;
+        };
+
+        RK_DECALRE_INTERFACE_PTR(RkImageAtlas);
+        RkImage atlasImage;
+        std::vector<Shelf> atlasShelves;
+        int shelvesHeight;
+        // Set when a copy of the whole sheet is given out.
+        bool imageShared;
+        std::unordered_map<std::string, RkRect> namedRegions;
+};
+
+#endif // RK_IMAGE_ATLAS_IMPL_H
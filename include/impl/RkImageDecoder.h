@@ -0,0 +1,64 @@
+/**
+ * File name: RkImageDecoder.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_DECODER_H
+#define RK_IMAGE_DECODER_H
+
+#include "RkImage.h"
+
+/**
+ * Decoder of the compact image resources generated by rkpng2c -c.
+ *
+ * Image, all the numbers are little endian:
+ *   "RKI1", format (1 byte: 0 ARGB32, 1 RGB32, 2 A8),
+ *   encoding (1 byte: 0 raw, 1 compressed), 2 reserved bytes,
+ *   width (uint32), height (uint32), payload size (uint32), payload.
+ *
+ * The compressed ARGB32/RGB32 payload uses the QOI operations on the
+ * native endian Cairo pixels, the A8 payload is PackBits-like RLE:
+ * a control byte c < 128 is followed by c + 1 literal bytes,
+ * c >= 128 is followed by one byte repeated c - 126 times.
+ *
+ * Blob (rkpng2c -d): "RKB1", images count (uint32), then for every image
+ * name length (uint16), name, offset of the image from the blob start (uint32).
+ */
+class RkImageDecoder {
+ public:
+        static constexpr size_t headerSize = 20;
+        static bool isImage(const unsigned char *data);
+        static bool imageInfo(const unsigned char *data, RkSize &size, RkImage::Format &format);
+        static size_t imageSize(const unsigned char *data);
+        static bool decode(const unsigned char *data, unsigned char *pixels, int stride);
+        static constexpr size_t blobHeaderSize = 8;
+        // The size is the size of the blob array, the index is not read past it.
+        static bool isBlob(const unsigned char *data, size_t size);
+        static const unsigned char* findImage(const unsigned char *blob, size_t size, const std::string &name);
+        // Images named "<name>@<scale>x" (e.g. knob@2x), the HiDPI variants of the image.
+        static std::vector<std::pair<double, const unsigned char*>>
+        findVariants(const unsigned char *blob, size_t size, const std::string &name);
+
+ private:
+        RkImageDecoder() = delete;
+};
+
+#endif // RK_IMAGE_DECODER_H
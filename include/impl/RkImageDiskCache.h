@@ -0,0 +1,105 @@
+/**
+ * File name: RkImageDiskCache.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_IMAGE_DISK_CACHE_H
+#define RK_IMAGE_DISK_CACHE_H
+
+#include "RkImage.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+/**
+ * On-disk cache of decoded images, used by RkImageRegistry.
+ *
+ * The file holds premultiplied, stride aligned pixels exactly as Cairo
+ * uses them, keyed by the hash of the source (encoded resource or PNG
+ * file content) and by the scale factor. The file is mapped read-only
+ * and the images reference the mapped pages directly, there is no decode
+ * and no copy. A changed source has a different hash, so it misses and
+ * is decoded again, sync() then rewrites the file with the new pixels.
+ *
+ * File, native endian:
+ *   Header, entries table, pixels of every entry aligned to 64 bytes.
+ */
+class RkImageDiskCache {
+ public:
+        struct Pixels {
+                const unsigned char *data = nullptr;
+                RkSize size;
+                RkImage::Format format = RkImage::Format::ARGB32;
+                int stride = 0;
+        };
+
+        RkImageDiskCache();
+        ~RkImageDiskCache();
+        bool open(const std::string &file);
+        bool isOpen() const;
+        Pixels find(uint64_t hash, double scale);
+        void insert(uint64_t hash, double scale, const RkImage &image);
+        bool sync();
+
+ private:
+        struct Header {
+                char magic[4];
+                uint32_t version;
+                uint32_t count;
+                uint32_t generation;
+                // FNV-1a of the entries table.
+                uint64_t tableHash;
+        };
+
+        struct Entry {
+                uint64_t hash;
+                double scale;
+                uint32_t format;
+                uint32_t width;
+                uint32_t height;
+                uint32_t stride;
+                uint64_t offset;
+                // Last generation (sync) the entry was used in.
+                uint32_t generation;
+                uint32_t reserved;
+        };
+
+        using Key = std::pair<uint64_t, double>;
+
+        bool map(const std::string &file);
+        bool isValid(const unsigned char *data, size_t size) const;
+
+        std::mutex cacheMutex;
+        std::string cacheFile;
+        std::atomic<bool> cacheOpen;
+        unsigned char *mappedData;
+        size_t mappedSize;
+        const Entry *mappedEntries;
+        uint32_t generation;
+        // Mapped entries index and the used flags.
+        std::map<Key, std::pair<const Entry*, bool>> index;
+        std::map<Key, RkImage> newEntries;
+        // Mappings replaced by sync(), still referenced by images.
+        std::vector<std::pair<unsigned char*, size_t>> oldMappings;
+};
+
+#endif // RK_IMAGE_DISK_CACHE_H
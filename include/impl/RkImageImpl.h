@@ -23,12 +23,26 @@
 
 #include "RkImage.h"
 
+#include <map>
+#include <mutex>
+
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
 class RkCairoImageBackendCanvas;
 #else
 #error No graphics backend defined.
 #endif
 
+// Resolution variants shared by the image copies, keyed by scale factor.
+struct RkImageVariants {
+        struct Variant {
+                RkImage image;
+                // Resampled by variant(), dropped when the image is written.
+                bool generated;
+        };
+        std::mutex variantsMutex;
+        std::map<double, Variant> variants;
+};
+
 class RkImage::RkImageImpl {
  public:
         RkImageImpl(RkImage *interface,
@@ -36,26 +50,52 @@ class RkImage::RkImageImpl {
                     int height,
                     const unsigned char *data,
                     RkImage::Format format = RkImage::Format::ARGB32);
+        // Shares the canvas of the other image.
+        RkImageImpl(RkImage *interface, const RkImageImpl &other);
+        // Takes the canvas of the other image, which becomes null.
+        RkImageImpl(RkImage *interface, RkImageImpl &&other);
         virtual ~RkImageImpl();
         const RkCanvasInfo *getCanvasInfo() const;
-        unsigned char* data() const;
+        unsigned char* data();
+        const unsigned char* constData() const;
         std::vector<unsigned char> dataCopy() const;
         Format format() const;
         int width() const;
         int height() const;
+        int stride() const;
         RkSize size() const;
         bool isNull() const;
-        void createImage(const RkSize &size,
-                         RkImage::Format format,
-                         const unsigned char *data);
+        bool isDecoded() const;
+        void share(const RkImageImpl &other);
+        void take(RkImageImpl &other);
+        void detach();
+        void borrow(const RkSize &size,
+                    RkImage::Format format,
+                    const unsigned char *data,
+                    int stride = 0);
+        long useCount() const;
+        bool load(const std::string &file);
+        bool loadResource(const unsigned char *resource);
+        bool isEqual(const RkImageImpl &other) const;
         void fill(const RkColor &color);
+        void fill(const RkColor &color, const RkRect &rect);
+        void applyAlpha(int alpha);
+        void scroll(int dx, int dy);
+        // Writes into the buffer even if it is shared with other images.
+        void paste(const RkImageImpl &image, int x, int y);
+        void setVariant(double scale, const RkImage &image);
+        bool hasVariants() const;
+        RkImage variant(double scale) const;
 
  private:
+        void dropGeneratedVariants();
         RK_DECALRE_INTERFACE_PTR(RkImage);
         RkImage::Format imageFormat;
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
-        std::unique_ptr<RkCairoImageBackendCanvas> imageBackendCanvas;
+        // Implicitly shared between image copies, detached on write.
+        std::shared_ptr<RkCairoImageBackendCanvas> imageBackendCanvas;
 #else
 #error No graphics backend defined
 #endif
+        std::shared_ptr<RkImageVariants> imageVariants;
 };
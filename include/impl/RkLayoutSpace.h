@@ -0,0 +1,57 @@
+/**
+ * File name: RkLayoutSpace.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_LAYOUT_SPACE_H
+#define RK_LAYOUT_SPACE_H
+
+#include "Rk.h"
+
+#include <vector>
+
+/**
+ * A row or a column of a layout: the preferred length, the limits
+ * and the stretch factor. The length is set by distribute().
+ */
+struct RkLayoutSlot {
+        int length = 0;
+        int minimum = 0;
+        int maximum = 1000000;
+        int stretch = 0;
+};
+
+class RkLayoutSpace {
+ public:
+        /**
+         * Grows or shrinks the stretched slots so that the slots fill the
+         * space, in proportion to the stretch and within the limits. The
+         * space a clamped slot can't take goes to the other stretched slots
+         * in the next pass, there are at most maxPasses linear passes.
+         */
+        static void distribute(std::vector<RkLayoutSlot> &slots, int space);
+        static int length(const std::vector<RkLayoutSlot> &slots);
+
+ private:
+        static constexpr int maxPasses = 4;
+};
+
+#endif // RK_LAYOUT_SPACE_H
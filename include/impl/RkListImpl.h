@@ -27,6 +27,7 @@
 #include "RkList.h"
 #include "RkWidgetImpl.h"
 #include "RkPainter.h"
+#include "RkModel.h"
 
 class RkModel;
 
@@ -37,11 +38,25 @@ class RkList::RkListImpl : public RkWidget::RkWidgetImpl {
         void drawList(RkPainter &painter);
         RkModel* getModel() const;
         size_t getIndex(int y) const;
+        int scrollOffset() const;
+        // Returns false if the offset didn't change.
+        bool setScrollOffset(int offset);
+        int maxScrollOffset() const;
+        int scrollOffsetForItem(size_t index) const;
+        // Visible items, [first, last).
+        std::pair<size_t, size_t> visibleItems() const;
+        // Return true if the visible items are affected.
+        bool itemsChanged(size_t first, size_t last) const;
+        bool itemsInserted(size_t first, size_t last);
+        bool itemsRemoved(size_t first, size_t last);
+
  private:
         RK_DECALRE_INTERFACE_PTR(RkList);
         RkModel* listModel;
         int topMargin;
         int leftMargin;
+        int listScrollOffset;
+        std::vector<RkModelRow> visibleRows;
 };
 
 #endif // RK_LIST_IMPL_H
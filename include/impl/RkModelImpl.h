@@ -32,11 +32,31 @@ class RkModel::RkModelImpl : public RkObject::RkObjectImpl {
         RkModelImpl(RkModel* interface, RkObject* parent);
         virtual ~RkModelImpl() = default;
         bool isItemSelected(size_t index) const;
+        size_t selectedItem() const;
         void selectItem(size_t index);
+        // Keep the selection on the same item.
+        void itemsInserted(size_t first, size_t last);
+        void itemsRemoved(size_t first, size_t last);
+        void beginUpdate();
+        // Returns true when the outermost update ended.
+        bool endUpdate();
+        bool isUpdating() const;
+        // Adds the changes to the pending notification, returns false if not updating.
+        bool deferStructureChange();
+        bool deferItemsChange(size_t first, size_t last, int role);
+        bool hasStructureChange() const;
+        // Clears the pending changes, returns false if no items changed.
+        bool takeItemsChange(size_t &first, size_t &last, int &role);
 
  private:
         RK_DECALRE_INTERFACE_PTR(RkModel);
         size_t selectedIndex;
+        int updateLevel;
+        bool structureChanged;
+        bool itemsChangePending;
+        size_t changedFirst;
+        size_t changedLast;
+        int changedRole;
 };
 
 #endif // RK_MODEL_IMPL_H
@@ -25,6 +25,7 @@
 #define RK_PAINTER_IMPL_H
 
 #include "RkPainter.h"
+#include "RkPicture.h"
 
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
 class RkCairoGraphicsBackend;
@@ -36,14 +37,21 @@ class RkPainter::RkPainterImpl {
  public:
         RkPainterImpl(RkPainter* interface, RkCanvas* canvas);
         ~RkPainterImpl();
-        void drawText(const std::string &text, int x, int y);
-        void drawImage(const std::string &file, int x, int y);
+        void drawText(std::string_view text, int x, int y);
         void drawImage(const RkImage &image, int x, int y);
+        void drawImage(const RkImage &image, const RkRect &source, int x, int y);
+        void drawMask(const RkImage &mask, int x, int y, const RkColor &color);
         void drawEllipse(const RkPoint& p, int width, int height);
         void drawLine(const RkPoint &p1, const RkPoint &p2);
         void drawRect(const RkRect &rect);
         void drawPolyline(const std::vector<RkPoint> &points);
+        void drawPath(const RkPath &path);
+        void fillPath(const RkPath &path, const RkColor &color);
         void fillRect(const RkRect &rect, const RkColor &color);
+        void drawLines(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
+        void drawRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void fillRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void drawPoints(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
         void applyAlpha(int alpha);
         const RkPen& pen() const;
         void setPen(const RkPen &pen);
@@ -51,10 +59,20 @@ class RkPainter::RkPainterImpl {
         void setFont(const RkFont &font);
         void translate(const RkPoint &offset);
         void rotate(rk_real angle);
-        int getTextWidth(const std::string &text) const;
+        int getTextWidth(std::string_view text) const;
+        void drawPicture(const RkPicture &picture, const RkRect &source, int x, int y);
+        void save();
+        void restore();
+        void setClip(const std::vector<RkRect> &rects);
+        RkRect clipBounds() const;
+        // False if the rectangle is entirely outside of the clip.
+        bool isVisible(const RkRect &rect) const;
 
  private:
+        void transformChanged();
         RK_DECALRE_INTERFACE_PTR(RkPainter);
+        // Not null when painting on a RkPicture, the drawing is recorded.
+        RkPicture::RkPictureImpl *pictureRecorder;
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
         std::unique_ptr<RkCairoGraphicsBackend> backendGraphics;
 #else
@@ -62,6 +80,14 @@ class RkPainter::RkPainterImpl {
 #endif
         RkPen painterPen;
         RkFont painterFont;
+        struct PainterState {
+                RkPen pen;
+                RkFont font;
+        };
+        std::vector<PainterState> statesStack;
+        // Clip bounds in user coordinates, updated when the transform or the clip change.
+        mutable RkRect clipRect;
+        mutable bool clipRectValid;
 };
 
 #endif // RK_PAINTER_IMPL_H
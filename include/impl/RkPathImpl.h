@@ -0,0 +1,75 @@
+/**
+ * File name: RkPathImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PATH_IMPL_H
+#define RK_PATH_IMPL_H
+
+#include "RkPath.h"
+
+#include <mutex>
+
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+struct cairo_path;
+#else
+#error No graphics backend defined
+#endif
+
+struct RkPathData {
+        std::vector<RkPath::Element> elements;
+        // Arguments of the elements: 2 for MoveTo and LineTo, 6 for CurveTo, 5 for ArcTo.
+        std::vector<rk_real> values;
+        // Guards the cached values below, the data may be shared between threads.
+        std::mutex cacheMutex;
+        bool boundsValid = false;
+        RkRect bounds;
+        size_t hash = 0;
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+        // Built by the backend on the first draw.
+        std::shared_ptr<cairo_path> cairoPath;
+#else
+#error No graphics backend defined
+#endif
+};
+
+class RkPath::RkPathImpl {
+ public:
+        explicit RkPathImpl(RkPath *interface);
+        ~RkPathImpl();
+        void share(const RkPathImpl &other);
+        void take(RkPathImpl &other);
+        void add(Element element, std::initializer_list<rk_real> values);
+        void clear();
+        bool isEmpty() const;
+        bool isEqual(const RkPathImpl &other) const;
+        RkRect boundingRect() const;
+        size_t hash() const;
+        std::shared_ptr<RkPathData> data() const;
+
+ private:
+        void detach();
+        RK_DECALRE_INTERFACE_PTR(RkPath);
+        // Implicitly shared between path copies, detached on write.
+        std::shared_ptr<RkPathData> pathData;
+};
+
+#endif // RK_PATH_IMPL_H
@@ -0,0 +1,149 @@
+/**
+ * File name: RkPictureImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PICTURE_IMPL_H
+#define RK_PICTURE_IMPL_H
+
+#include "RkPicture.h"
+#include "RkImage.h"
+#include "RkPoint.h"
+#include "RkPen.h"
+#include "RkRect.h"
+#include "RkFont.h"
+#include "RkPath.h"
+
+#include <string_view>
+
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+class RkCairoGraphicsBackend;
+#else
+#error No graphics backend defined
+#endif
+
+/**
+ * The recorded commands. Each command is an opcode followed by its integer
+ * arguments. Strings, images, paths and nested pictures are kept aside and are
+ * referenced by index.
+ */
+struct RkPictureData {
+        std::vector<int32_t> commands;
+        std::vector<std::string> strings;
+        std::vector<RkImage> images;
+        std::vector<RkPicture> pictures;
+        std::vector<RkPath> paths;
+};
+
+class RkPicture::RkPictureImpl {
+ public:
+        enum class Command : int32_t {
+                Text      = 0,
+                Image     = 1,
+                ImageRect = 2,
+                Mask      = 3,
+                Ellipse   = 4,
+                Line      = 5,
+                Rect      = 6,
+                Polyline  = 7,
+                FillRect  = 8,
+                Alpha     = 9,
+                Pen       = 10,
+                Font      = 11,
+                Translate = 12,
+                Rotate    = 13,
+                Picture   = 14,
+                Lines     = 15,
+                Rects     = 16,
+                FillRects = 17,
+                Points    = 18,
+                Save      = 19,
+                Restore   = 20,
+                Clip      = 21,
+                Path      = 22,
+                FillPath  = 23
+        };
+
+        explicit RkPictureImpl(RkPicture *interface);
+        virtual ~RkPictureImpl();
+        void share(const RkPictureImpl &other);
+        void take(RkPictureImpl &other);
+        void detach();
+        void clear();
+        bool isEmpty() const;
+        size_t size() const;
+        size_t hash() const;
+        bool isEqual(const RkPictureImpl &other) const;
+        void drawText(std::string_view text, int x, int y);
+        void drawImage(const RkImage &image, int x, int y);
+        void drawImage(const RkImage &image, const RkRect &source, int x, int y);
+        void drawMask(const RkImage &mask, int x, int y, const RkColor &color);
+        void drawEllipse(const RkPoint& p, int width, int height);
+        void drawLine(const RkPoint &p1, const RkPoint &p2);
+        void drawRect(const RkRect &rect);
+        void drawPolyline(const std::vector<RkPoint> &points);
+        void drawPath(const RkPath &path);
+        void fillPath(const RkPath &path, const RkColor &color);
+        void fillRect(const RkRect &rect, const RkColor &color);
+        void drawLines(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
+        void drawRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void fillRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors);
+        void drawPoints(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors);
+        void applyAlpha(int alpha);
+        void setPen(const RkPen &pen);
+        void setFont(const RkFont &font);
+        void translate(const RkPoint &offset);
+        void rotate(rk_real angle);
+        void drawPicture(const RkPicture &picture, const RkRect &source, int x, int y);
+        void save();
+        void restore();
+        void clip(const std::vector<RkRect> &rects);
+        /**
+         * Replays the commands on the backend with the picture origin at (x, y).
+         * If the source rectangle is not empty only that part of the picture
+         * is drawn, with the source top-left corner at (x, y).
+         */
+        void replay(RkCairoGraphicsBackend *backend,
+                    const RkRect &source = RkRect(),
+                    int x = 0,
+                    int y = 0) const;
+
+ private:
+        RkPictureData& record(Command command);
+        static int32_t packColor(const RkColor &color);
+        static RkColor unpackColor(int32_t value);
+        void recordPoints(Command command,
+                          const std::vector<RkPoint> &points,
+                          const std::vector<RkColor> &colors);
+        void recordRects(Command command,
+                         const std::vector<RkRect> &rects,
+                         const std::vector<RkColor> &colors);
+        static std::vector<RkPoint> readPoints(const std::vector<int32_t> &cmd, size_t &i);
+        static std::vector<RkRect> readRects(const std::vector<int32_t> &cmd, size_t &i);
+        static std::vector<RkColor> readColors(const std::vector<int32_t> &cmd, size_t &i);
+        RK_DECALRE_INTERFACE_PTR(RkPicture);
+        // Implicitly shared between picture copies, detached on write.
+        std::shared_ptr<RkPictureData> pictureData;
+        // Cached hash, 0 when not computed yet.
+        mutable size_t pictureHash;
+};
+
+#endif // RK_PICTURE_IMPL_H
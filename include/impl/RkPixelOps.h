@@ -0,0 +1,87 @@
+/**
+ * File name: RkPixelOps.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PIXEL_OPS_H
+#define RK_PIXEL_OPS_H
+
+#include "Rk.h"
+#include "RkColor.h"
+
+#include <cstdint>
+
+/**
+ * Pixel operations on 32 bit native endian ARGB pixels, with
+ * premultiplied alpha (the Cairo ARGB32 layout). The implementation
+ * is selected at runtime: AVX2 or SSE2 when the CPU supports them,
+ * scalar code otherwise.
+ */
+class RkPixelOps {
+ public:
+        enum class Backend : int {
+                Scalar = 0,
+                SSE2   = 1,
+                AVX2   = 2
+        };
+
+        static Backend backend();
+        // Forces a backend, clamped to what the CPU supports. Used for benchmarking.
+        static void setBackend(Backend backend);
+
+        static uint32_t pixel(const RkColor &color);
+        static RkColor color(uint32_t pixel);
+        static void fill(uint32_t *dst, size_t n, uint32_t pixel);
+        static void fillRect(unsigned char *data,
+                             int stride,
+                             int x,
+                             int y,
+                             int width,
+                             int height,
+                             uint32_t pixel);
+        // Moves the pixels by dx, dy, the exposed area is not changed.
+        static void scroll(unsigned char *data,
+                           int stride,
+                           int width,
+                           int height,
+                           int pixelLength,
+                           int dx,
+                           int dy);
+        static void applyAlpha(uint32_t *pixels, size_t n, int alpha);
+        /**
+         * High quality resampling of 8 bit channels (premultiplied ARGB32 or A8):
+         * box filter (area average) when downscaling, bilinear when upscaling.
+         */
+        static void resample(const unsigned char *src,
+                             int srcStride,
+                             int srcWidth,
+                             int srcHeight,
+                             unsigned char *dst,
+                             int dstStride,
+                             int dstWidth,
+                             int dstHeight,
+                             int channels);
+
+ private:
+        RkPixelOps() = delete;
+};
+
+#endif // RK_PIXEL_OPS_H
@@ -0,0 +1,81 @@
+/**
+ * File name: RkProxyModelImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_PROXY_MODEL_IMPL_H
+#define RK_PROXY_MODEL_IMPL_H
+
+#include "RkProxyModel.h"
+#include "RkModelImpl.h"
+
+class RkProxyModel::RkProxyModelImpl : public RkModel::RkModelImpl {
+ public:
+        // Ranges of proxy items, [first, last].
+        using Ranges = std::vector<std::pair<size_t, size_t>>;
+
+        RkProxyModelImpl(RkProxyModel* interface, RkObject* parent, RkModel *source);
+        virtual ~RkProxyModelImpl() = default;
+        RkModel* sourceModel() const;
+        // Return true if the items changed.
+        bool setFilter(const std::string &text);
+        const std::string& filter() const;
+        bool setSortOrder(SortOrder order);
+        SortOrder sortOrder() const;
+        size_t mapToSource(size_t index) const;
+        size_t mapFromSource(size_t sourceIndex) const;
+        size_t itemsNumber() const;
+        void itemsData(size_t first, size_t count, int dataTypes, RkModelRow *rows) const;
+        void itemsText(size_t first, size_t count, int dataType, RkModelRow *rows) const;
+        // Reloads the source data and maps the items again.
+        void reset();
+        // Return false if the items were mapped again instead.
+        bool sourceItemsInserted(size_t first, size_t last, Ranges &inserted);
+        bool sourceItemsRemoved(size_t first, size_t last, Ranges &removed);
+        bool sourceItemsChanged(size_t first, size_t last, int role, size_t &proxyFirst, size_t &proxyLast);
+
+ protected:
+        void loadKeys(size_t first, size_t last);
+        bool matches(size_t sourceIndex) const;
+        bool lessThan(size_t a, size_t b) const;
+        const std::vector<size_t>& sortedSource();
+        void sortRows(std::vector<size_t> &rows) const;
+        void mapRows();
+        // Calls fetch(source, n, offset) for each run of consecutive source items.
+        template<class Fetch>
+        void fetchSourceRows(size_t first, size_t count, Fetch fetch) const;
+
+ private:
+        RK_DECALRE_INTERFACE_PTR(RkProxyModel);
+        RkModel *sourceItemsModel;
+        std::string filterText;
+        SortOrder itemsOrder;
+        // Lowercase string data of the source items.
+        std::vector<std::string> sourceKeys;
+        std::vector<size_t> proxyRows;
+        std::vector<size_t> sortedRows;
+        bool sortedRowsValid;
+        mutable std::vector<size_t> sourceRows;
+        mutable bool sourceRowsValid;
+        std::vector<RkModelRow> fetchRows;
+};
+
+#endif // RK_PROXY_MODEL_IMPL_H
@@ -0,0 +1,80 @@
+/**
+ * File name: RkScrollAreaImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_SCROLL_AREA_IMPL_H
+#define RK_SCROLL_AREA_IMPL_H
+
+#include "RkScrollArea.h"
+#include "RkWidgetImpl.h"
+#include "RkPainter.h"
+#include "RkImage.h"
+
+#include <unordered_map>
+
+class RkScrollArea::RkScrollAreaImpl : public RkWidget::RkWidgetImpl {
+ public:
+        RkScrollAreaImpl(RkScrollArea *interface, RkWidget *parent);
+        virtual ~RkScrollAreaImpl() = default;
+        void setContentSize(const RkSize &size);
+        const RkSize& contentSize() const;
+        // Returns false if the position didn't change.
+        bool setScrollPosition(const RkPoint &position);
+        const RkPoint& scrollPosition() const;
+        RkPoint maxScrollPosition() const;
+        void invalidateContent(const RkRect &rect);
+        void invalidateContent();
+        void setTileSize(int size);
+        int tileSize() const;
+        void setTilesLimit(size_t limit);
+        size_t tilesLimit() const;
+        void draw(RkPainter &painter);
+
+ protected:
+        struct Tile {
+                // Null while the tile is drawn.
+                RkImage image;
+                RkSize size;
+                // The part to draw again, in tile coordinates.
+                RkRect dirtyRect;
+                uint64_t lastUse;
+        };
+
+        static uint64_t tileKey(int column, int row);
+        RkImage tile(int column, int row);
+        void invalidateView(const RkRect &rect);
+        void removeUnusedTiles();
+
+ private:
+        RK_DECALRE_INTERFACE_PTR(RkScrollArea);
+        RkSize areaContentSize;
+        RkPoint areaScrollPosition;
+        int areaTileSize;
+        size_t areaTilesLimit;
+        std::unordered_map<uint64_t, Tile> contentTiles;
+        uint64_t paintCounter;
+        RkImage viewImage;
+        bool viewValid;
+        RkRect viewDirtyRect;
+};
+
+#endif // RK_SCROLL_AREA_IMPL_H
@@ -0,0 +1,114 @@
+/**
+ * File name: RkTableViewImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_TABLE_VIEW_IMPL_H
+#define RK_TABLE_VIEW_IMPL_H
+
+#include "RkTableView.h"
+#include "RkWidgetImpl.h"
+#include "RkPainter.h"
+#include "RkImage.h"
+
+#include <map>
+
+class RkTableView::RkTableViewImpl : public RkWidget::RkWidgetImpl {
+ public:
+        RkTableViewImpl(RkTableView *interface, RkWidget *parent, RkModel *model);
+        virtual ~RkTableViewImpl() = default;
+        RkModel* getModel() const;
+        size_t addColumn(const std::string &title, int width, int dataType);
+        size_t columnsNumber() const;
+        std::string columnTitle(size_t column) const;
+        // Return false if nothing changed.
+        bool setColumnWidth(size_t column, int width);
+        int columnWidth(size_t column) const;
+        void setColumnResizable(size_t column, bool resizable);
+        bool isColumnResizable(size_t column) const;
+        int contentsWidth(size_t column);
+        bool setHeaderHeight(int height);
+        int headerHeight() const;
+        int scrollOffset() const;
+        bool setScrollOffset(int offset);
+        int maxScrollOffset() const;
+        int horizontalScrollOffset() const;
+        bool setHorizontalScrollOffset(int offset);
+        int maxHorizontalScrollOffset() const;
+        int scrollOffsetForItem(size_t index) const;
+        size_t getIndex(int y) const;
+        size_t getColumn(int x) const;
+        // The column with the right edge at x in the header, -1 if none.
+        size_t resizeHandleAt(int x, int y) const;
+        void startResize(size_t column, int x);
+        bool isResizing() const;
+        // Returns false if not resizing.
+        bool resize(int x, int &width);
+        size_t resizedColumn() const;
+        void stopResize();
+        void draw(RkPainter &painter);
+        void invalidate();
+        // Return true if the visible rows are affected.
+        bool itemsChanged(size_t first, size_t last);
+        bool itemsInserted(size_t first, size_t last);
+        bool itemsRemoved(size_t first, size_t last);
+
+ protected:
+        struct Column {
+                std::string title;
+                int width;
+                int dataType;
+                bool resizable;
+                // Text widths measured with the painter font, looked up
+                // by string_view without building a key string.
+                std::map<std::string, int, std::less<>> textWidths;
+        };
+
+        RkSize bodySize() const;
+        int tableWidth() const;
+        // Visible items, [first, last).
+        std::pair<size_t, size_t> visibleItems() const;
+        void scrollBody(int dx, int dy);
+        void invalidate(const RkRect &rect);
+        void drawCells(RkPainter &painter, const RkRect &area);
+        void drawHeader(RkPainter &painter);
+        int textWidth(RkPainter &painter, Column &column, std::string_view text);
+
+ private:
+        RK_DECALRE_INTERFACE_PTR(RkTableView);
+        RkModel* tableModel;
+        std::vector<Column> tableColumns;
+        int tableHeaderHeight;
+        int textMargin;
+        int verticalOffset;
+        int horizontalOffset;
+        RkImage bodyImage;
+        bool bodyValid;
+        RkRect dirtyRect;
+        size_t resizingColumn;
+        int resizeStartX;
+        int resizeStartWidth;
+        std::vector<RkModelRow> visibleRows;
+        // The text of the visible cells, one strip of rows per column.
+        std::vector<RkModelRow> visibleCells;
+};
+
+#endif // RK_TABLE_VIEW_IMPL_H
@@ -0,0 +1,50 @@
+/**
+ * File name: RkTreeModelImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_TREE_MODEL_IMPL_H
+#define RK_TREE_MODEL_IMPL_H
+
+#include "RkTreeModel.h"
+#include "RkObjectImpl.h"
+
+#include <mutex>
+
+// Shared with the fetch pool, which posts the results only if not cancelled.
+struct RkTreeFetchState {
+        std::mutex fetchMutex;
+        bool cancelled = false;
+};
+
+class RkTreeModel::RkTreeModelImpl : public RkObject::RkObjectImpl {
+ public:
+        RkTreeModelImpl(RkTreeModel* interface, RkObject* parent);
+        virtual ~RkTreeModelImpl() = default;
+        const std::shared_ptr<RkTreeFetchState>& fetchState() const;
+        void cancelFetches();
+
+ private:
+        RK_DECALRE_INTERFACE_PTR(RkTreeModel);
+        std::shared_ptr<RkTreeFetchState> treeFetchState;
+};
+
+#endif // RK_TREE_MODEL_IMPL_H
@@ -0,0 +1,109 @@
+/**
+ * File name: RkTreeViewImpl.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_TREE_VIEW_IMPL_H
+#define RK_TREE_VIEW_IMPL_H
+
+#include "RkTreeView.h"
+#include "RkWidgetImpl.h"
+#include "RkPainter.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+class RkTreeView::RkTreeViewImpl : public RkWidget::RkWidgetImpl {
+ public:
+        RkTreeViewImpl(RkTreeView *interface, RkWidget *parent, RkTreeModel *model);
+        virtual ~RkTreeViewImpl() = default;
+        RkTreeModel* getModel() const;
+        // Return false if nothing changed.
+        bool expand(NodeId node);
+        bool collapse(NodeId node);
+        bool isExpanded(NodeId node) const;
+        void setIndentation(int indentation);
+        int indentation() const;
+        size_t rowsNumber() const;
+        size_t rowAt(int y) const;
+        NodeId rowNode(size_t row) const;
+        // Returns true if x is on the expand sign of the row.
+        bool isOnExpander(size_t row, int x) const;
+        NodeId selectedNode() const;
+        bool selectNode(NodeId node);
+        int scrollOffset() const;
+        bool setScrollOffset(int offset);
+        int maxScrollOffset() const;
+        void drawTree(RkPainter &painter);
+        // Rebuilds the rows from the expanded nodes.
+        void reset();
+        // Return true if the visible rows are affected.
+        bool childrenInserted(NodeId parent, size_t first, size_t last);
+        bool childrenRemoved(NodeId parent, size_t first, size_t last);
+        bool nodeChanged(NodeId node) const;
+
+ protected:
+        struct Row {
+                NodeId node;
+                NodeId parent;
+                int depth;
+                // The number of the rows of the expanded descendants.
+                size_t descendants;
+        };
+
+        // Returns -1 for the root and if the node has no row.
+        size_t findRow(NodeId node) const;
+        // The rows of the children of the parent, the counts of the ancestors are updated.
+        void insertRows(size_t row, NodeId parent, const std::vector<Row> &rows);
+        void eraseRows(size_t row, size_t end, NodeId parent);
+        void addDescendants(NodeId parent, size_t count, bool removed);
+        // The end of the rows of the descendants of the row.
+        size_t subtreeEnd(size_t row) const;
+        // The row of the child of the parent row, or where it would be.
+        size_t childRow(size_t parentRow, size_t index) const;
+        // Appends the rows of the children and of their expanded descendants.
+        void addChildren(std::vector<Row> &rows, NodeId parent, int depth, size_t first, size_t last) const;
+        std::pair<size_t, size_t> visibleRows() const;
+        // Keeps the visible rows in place when rows change above them.
+        bool rowsInserted(size_t row, size_t count);
+        bool rowsRemoved(size_t row, size_t count);
+
+ private:
+        RK_DECALRE_INTERFACE_PTR(RkTreeView);
+        RkTreeModel *treeModel;
+        std::vector<Row> treeRows;
+        /**
+         * The rows of the nodes, built lazily by findRow(). Only the entries
+         * of the first indexedRows rows are valid, the rows after an
+         * insertion or removal are indexed again when they are looked up.
+         */
+        mutable std::unordered_map<NodeId, size_t> rowIndex;
+        mutable size_t indexedRows;
+        std::unordered_set<NodeId> expandedNodes;
+        NodeId selectedTreeNode;
+        int treeIndentation;
+        int leftMargin;
+        int treeScrollOffset;
+        RkPath expandedSign;
+        RkPath collapsedSign;
+};
+
+#endif // RK_TREE_VIEW_IMPL_H
@@ -26,6 +26,7 @@
 
 #include "RkWidget.h"
 #include "RkObjectImpl.h"
+#include "RkWidgetIndex.h"
 
 #ifdef RK_OS_WIN
 class RkWindowWin;
@@ -101,8 +102,15 @@ class RkWidget::RkWidgetImpl : public RkObject::RkObjectImpl {
         bool pointerIsOverWindow() const;
         void setScaleFactor(double factor);
         double scaleFactor() const;
+        // The spatial index of the top widget this widget belongs to.
+        RkWidgetIndex* widgetIndex() const;
+        // The position in the top widget coordinates.
+        RkPoint indexPosition() const;
 
  private:
+        void initIndex(RkWidget *parent, Rk::WindowFlags flags, bool isTopWindow);
+        void updateIndex();
+
         RK_DECALRE_INTERFACE_PTR(RkWidget);
 #ifdef RK_OS_WIN
         std::unique_ptr<RkWindowWin> platformWindow;
@@ -126,6 +134,13 @@ class RkWidget::RkWidgetImpl : public RkObject::RkObjectImpl {
 	bool isWidgetSown;
         bool isGrabKeyEnabled;
         bool isPropagateGrabKey;
+        // The parent widget when it has the same top widget, null otherwise.
+        RkWidgetImpl *parentImpl;
+        RkPoint widgetPosition;
+        std::unique_ptr<RkWidgetIndex> topWidgetIndex;
+        RkWidgetIndex *topIndex;
+        RkPoint topIndexPosition;
+        std::vector<uint64_t> widgetStackOrder;
 };
 
 #endif // RK_WIDGET_IMPL_H
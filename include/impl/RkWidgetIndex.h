@@ -0,0 +1,87 @@
+/**
+ * File name: RkWidgetIndex.h
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef RK_WIDGET_INDEX_H
+#define RK_WIDGET_INDEX_H
+
+#include "Rk.h"
+#include "RkRect.h"
+
+#include <unordered_map>
+
+class RkWidget;
+
+/**
+ * Spatial index of the visible widgets of a top widget, in the top widget
+ * coordinates. The rectangles are kept in a uniform grid of cells, a query
+ * looks only at the widgets in the cells it touches. Widgets covering many
+ * cells are kept apart and checked by every query.
+ *
+ * The stacking order of a widget is the path of creation numbers from the
+ * top widget to it: children are above their parent, and among siblings
+ * the one created later is above.
+ */
+class RkWidgetIndex {
+ public:
+        explicit RkWidgetIndex(int cellSize = defaultCellSize);
+        /**
+         * Adds the widget or updates its rectangle, an empty rectangle removes it.
+         * The stack order of a widget doesn't change, it is kept from the insertion.
+         */
+        void update(RkWidget *widget, const RkRect &rect, const std::vector<uint64_t> &stackOrder);
+        void remove(RkWidget *widget);
+        bool contains(RkWidget *widget) const;
+        RkRect rect(RkWidget *widget) const;
+        // The topmost widget at the point.
+        RkWidget* widgetAt(const RkPoint &point) const;
+        // The widgets at the point, from the bottom to the top.
+        std::vector<RkWidget*> widgetsAt(const RkPoint &point) const;
+        // The widgets intersecting the rectangle, from the bottom to the top.
+        std::vector<RkWidget*> widgets(const RkRect &rect) const;
+        size_t size() const;
+
+ private:
+        RK_DISABLE_COPY(RkWidgetIndex);
+        RK_DISABLE_MOVE(RkWidgetIndex);
+        static constexpr int defaultCellSize = 64;
+        static constexpr int largeEntryCells = 64;
+        struct Entry {
+                RkWidget *widget;
+                RkRect rect;
+                std::vector<uint64_t> stackOrder;
+                bool isLarge;
+                mutable uint64_t queryId;
+        };
+        int cell(int coordinate) const;
+        static uint64_t cellKey(int column, int row);
+        void insertCells(Entry *entry);
+        void removeCells(Entry *entry);
+        std::vector<RkWidget*> sorted(std::vector<const Entry*> &entries) const;
+        std::unordered_map<RkWidget*, std::unique_ptr<Entry>> indexEntries;
+        std::unordered_map<uint64_t, std::vector<Entry*>> indexCells;
+        std::vector<Entry*> largeEntries;
+        int indexCellSize;
+        mutable uint64_t queryCounter;
+};
+
+#endif // RK_WIDGET_INDEX_H
@@ -47,7 +47,12 @@ std::string RkButton::text() const
 
 void RkButton::setImage(const RkImage &img, RkButton::State state)
 {
-        impl_ptr->setImage(img, state);
+        setImage(RkImageRegion(img), state);
+}
+
+void RkButton::setImage(const RkImageRegion &region, RkButton::State state)
+{
+        impl_ptr->setImage(region, state);
         update();
 }
 
@@ -43,11 +43,11 @@ RkString RkButton::RkButtonImpl::text() const
         return buttonText;
 }
 
-void RkButton::RkButtonImpl::setImage(const RkImage &img, RkButton::State state)
+void RkButton::RkButtonImpl::setImage(const RkImageRegion &region, RkButton::State state)
 {
-        buttonImages[static_cast<size_t>(state)] = img;
+        buttonImages[static_cast<size_t>(state)] = region;
         if (state == RkButton::State::Unpressed)
-                inf_ptr->setSize(img.size());
+                inf_ptr->setSize(region.size());
 }
 
 bool RkButton::RkButtonImpl::isPressed() const
@@ -24,13 +24,36 @@
 #include "RkCairoGraphicsBackend.h"
 #include "RkCanvas.h"
 #include "RkCanvasInfo.h"
+#include "RkPathImpl.h"
 #include "RkLog.h"
 
 #include <math.h>
+#include <algorithm>
+#include <numeric>
 
 RkCairoGraphicsBackend::RkCairoGraphicsBackend(RkCanvas *canvas)
-        : cairoContext{cairo_create(canvas->getCanvasInfo()->cairo_surface)}
+        : cairoContext{nullptr}
+        , deviceScale{1.0}
 {
+        canvas->beginPaint();
+        cairoContext = cairo_create(canvas->getCanvasInfo()->cairo_surface);
+        double scaleY;
+        cairo_surface_get_device_scale(canvas->getCanvasInfo()->cairo_surface, &deviceScale, &scaleY);
+        cairo_set_font_size(context(), 10);
+        cairo_set_line_width (context(), 1);
+}
+
+/**
+ * Backend without a canvas, nothing is drawn. Used while recording pictures
+ * to measure text and to keep track of the transformation and clip.
+ */
+RkCairoGraphicsBackend::RkCairoGraphicsBackend()
+        : cairoContext{nullptr}
+        , deviceScale{1.0}
+{
+        auto surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, nullptr);
+        cairoContext = cairo_create(surface);
+        cairo_surface_destroy(surface);
         cairo_set_font_size(context(), 10);
         cairo_set_line_width (context(), 1);
 }
@@ -45,26 +68,103 @@ RkCairoGraphicsBackend::~RkCairoGraphicsBackend()
         cairo_destroy(context());
 }
 
+const char* RkCairoGraphicsBackend::terminated(std::string_view text) const
+{
+        textBuffer.assign(text.data(), text.size());
+        return textBuffer.c_str();
+}
+
 void RkCairoGraphicsBackend::drawText(const std::string &text, int x, int y)
 {
         cairo_move_to(context(), x, y);
         cairo_show_text(context(), text.c_str());
 }
 
-void RkCairoGraphicsBackend::drawImage(const std::string &file, int x, int y)
+void RkCairoGraphicsBackend::drawText(std::string_view text, int x, int y)
+{
+        cairo_move_to(context(), x, y);
+        cairo_show_text(context(), terminated(text));
+}
+
+cairo_pattern_t* RkCairoGraphicsBackend::imagePattern(const RkImage &image,
+                                                      const RkImage &variant,
+                                                      int x,
+                                                      int y) const
 {
-        auto image = cairo_image_surface_create_from_png(file.c_str());
-        cairo_set_source_surface(context(), image, x, y);
-        cairo_paint(context());
-        cairo_surface_destroy(image);
+        auto pattern = cairo_pattern_create_for_surface(variant.getCanvasInfo()->cairo_surface);
+        cairo_matrix_t matrix;
+        cairo_matrix_init_scale(&matrix,
+                                static_cast<double>(variant.width()) / image.width(),
+                                static_cast<double>(variant.height()) / image.height());
+        cairo_matrix_translate(&matrix, -x, -y);
+        cairo_pattern_set_matrix(pattern, &matrix);
+        return pattern;
+}
+
+/**
+ * Calls paint with the pattern of the image variant matching the device
+ * pixels on scaled (HiDPI) surfaces, so Cairo doesn't resample the image
+ * on every paint. The pattern is null when the image is painted as it is,
+ * at 1x or when it has no variants.
+ */
+template<class Paint>
+void RkCairoGraphicsBackend::paintImage(const RkImage &image, int x, int y, Paint paint)
+{
+        if (fabs(deviceScale - 1.0) >= 1e-6 && image.hasVariants()) {
+                // The copy keeps the pixels until the paint is done, a change
+                // through another copy of the image can drop the cached variant.
+                auto variant = image.variant(deviceScale);
+                if (variant.width() != image.width() || variant.height() != image.height()) {
+                        auto pattern = imagePattern(image, variant, x, y);
+                        paint(pattern);
+                        cairo_pattern_destroy(pattern);
+                        return;
+                }
+        }
+        paint(nullptr);
 }
 
 void RkCairoGraphicsBackend::drawImage(const RkImage &image, int x, int y)
 {
-        cairo_set_source_surface(context(),
-                                 image.getCanvasInfo()->cairo_surface,
-                                 x, y);
-        cairo_paint(context());
+        paintImage(image, x, y, [&](cairo_pattern_t *pattern) {
+                        if (pattern)
+                                cairo_set_source(context(), pattern);
+                        else
+                                cairo_set_source_surface(context(), image.getCanvasInfo()->cairo_surface, x, y);
+                        cairo_paint(context());
+                });
+}
+
+void RkCairoGraphicsBackend::drawImage(const RkImage &image, const RkRect &source, int x, int y)
+{
+        auto left = x - source.left();
+        auto top = y - source.top();
+        paintImage(image, left, top, [&](cairo_pattern_t *pattern) {
+                        if (pattern)
+                                cairo_set_source(context(), pattern);
+                        else
+                                cairo_set_source_surface(context(), image.getCanvasInfo()->cairo_surface, left, top);
+                        cairo_rectangle(context(), x, y, source.width(), source.height());
+                        cairo_fill(context());
+                });
+}
+
+void RkCairoGraphicsBackend::drawMask(const RkImage &mask, int x, int y, const RkColor &color)
+{
+        // Keep the pen color as the source for the next drawing operations.
+        cairo_save(context());
+        cairo_set_source_rgba(context(),
+                              static_cast<double>(color.red()) / 255,
+                              static_cast<double>(color.green()) / 255,
+                              static_cast<double>(color.blue()) / 255,
+                              static_cast<double>(color.alpha()) / 255);
+        paintImage(mask, x, y, [&](cairo_pattern_t *pattern) {
+                        if (pattern)
+                                cairo_mask(context(), pattern);
+                        else
+                                cairo_mask_surface(context(), mask.getCanvasInfo()->cairo_surface, x, y);
+                });
+        cairo_restore(context());
 }
 
 void RkCairoGraphicsBackend::drawEllipse(const RkPoint& p, int width, int height)
@@ -178,6 +278,78 @@ void RkCairoGraphicsBackend::drawPolyLine(const std::vector<RkPoint> &points)
         cairo_stroke(context());
 }
 
+/**
+ * Sets the path as the current Cairo path. The Cairo path is built once,
+ * with the identity matrix, and is kept in the path data for the next draws.
+ */
+void RkCairoGraphicsBackend::appendPath(const RkPath &path)
+{
+        auto data = path.o_ptr->data();
+        std::lock_guard<std::mutex> lock(data->cacheMutex);
+        if (!data->cairoPath) {
+                cairo_save(context());
+                cairo_identity_matrix(context());
+                cairo_new_path(context());
+                const auto &v = data->values;
+                size_t i = 0;
+                for (auto element: data->elements) {
+                        switch (element)
+                        {
+                        case RkPath::Element::MoveTo:
+                                cairo_move_to(context(), v[i], v[i + 1]);
+                                i += 2;
+                                break;
+                        case RkPath::Element::LineTo:
+                                cairo_line_to(context(), v[i], v[i + 1]);
+                                i += 2;
+                                break;
+                        case RkPath::Element::CurveTo:
+                                cairo_curve_to(context(), v[i], v[i + 1], v[i + 2], v[i + 3], v[i + 4], v[i + 5]);
+                                i += 6;
+                                break;
+                        case RkPath::Element::ArcTo:
+                                if (v[i + 4] >= v[i + 3])
+                                        cairo_arc(context(), v[i], v[i + 1], v[i + 2], v[i + 3], v[i + 4]);
+                                else
+                                        cairo_arc_negative(context(), v[i], v[i + 1], v[i + 2], v[i + 3], v[i + 4]);
+                                i += 5;
+                                break;
+                        case RkPath::Element::Close:
+                                cairo_close_path(context());
+                                break;
+                        default:
+                                break;
+                        }
+                }
+                data->cairoPath = std::shared_ptr<cairo_path_t>(cairo_copy_path(context()), cairo_path_destroy);
+                cairo_new_path(context());
+                cairo_restore(context());
+        }
+
+        cairo_new_path(context());
+        cairo_append_path(context(), data->cairoPath.get());
+}
+
+void RkCairoGraphicsBackend::drawPath(const RkPath &path)
+{
+        appendPath(path);
+        cairo_stroke(context());
+}
+
+void RkCairoGraphicsBackend::fillPath(const RkPath &path, const RkColor &color)
+{
+        // Keep the pen color as the source for the next drawing operations.
+        cairo_save(context());
+        cairo_set_source_rgba(context(),
+                              static_cast<double>(color.red()) / 255,
+                              static_cast<double>(color.green()) / 255,
+                              static_cast<double>(color.blue()) / 255,
+                              static_cast<double>(color.alpha()) / 255);
+        appendPath(path);
+        cairo_fill(context());
+        cairo_restore(context());
+}
+
 void RkCairoGraphicsBackend::fillRect(const RkRect &rect, const RkColor &color)
 {
         cairo_rectangle(context(), rect.left(), rect.top(), rect.width(), rect.height());
@@ -189,6 +361,110 @@ void RkCairoGraphicsBackend::fillRect(const RkRect &rect, const RkColor &color)
         cairo_fill(context());
 }
 
+/**
+ * Adds the items to one path per color and strokes or fills each path once,
+ * instead of once per item. The items are grouped by color, so the stacking
+ * order of overlapping items with different colors is not kept.
+ */
+template<class AddItem>
+void RkCairoGraphicsBackend::drawBuckets(size_t n,
+                                         const std::vector<RkColor> &colors,
+                                         AddItem addItem,
+                                         bool fill)
+{
+        auto setColor = [this](const RkColor &color) {
+                cairo_set_source_rgba(context(),
+                                      static_cast<double>(color.red()) / 255,
+                                      static_cast<double>(color.green()) / 255,
+                                      static_cast<double>(color.blue()) / 255,
+                                      static_cast<double>(color.alpha()) / 255);
+        };
+        auto draw = [this, fill]() {
+                if (fill)
+                        cairo_fill(context());
+                else
+                        cairo_stroke(context());
+        };
+
+        // Keep the pen color as the source for the next drawing operations.
+        cairo_save(context());
+        if (colors.size() != n) {
+                if (!colors.empty())
+                        setColor(colors.front());
+                for (size_t i = 0; i < n; i++)
+                        addItem(i);
+                draw();
+        } else {
+                auto key = [&colors](size_t i) {
+                        const auto &c = colors[i];
+                        return (static_cast<uint32_t>(c.red() & 0xff) << 24)
+                                | (static_cast<uint32_t>(c.green() & 0xff) << 16)
+                                | (static_cast<uint32_t>(c.blue() & 0xff) << 8)
+                                | static_cast<uint32_t>(c.alpha() & 0xff);
+                };
+                std::vector<size_t> order(n);
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(),
+                                 [&key](size_t a, size_t b) { return key(a) < key(b); });
+                for (size_t i = 0; i < n;) {
+                        auto bucketKey = key(order[i]);
+                        setColor(colors[order[i]]);
+                        for (; i < n && key(order[i]) == bucketKey; i++)
+                                addItem(order[i]);
+                        draw();
+                }
+        }
+        cairo_restore(context());
+}
+
+void RkCairoGraphicsBackend::drawLines(const std::vector<RkPoint> &points,
+                                       const std::vector<RkColor> &colors)
+{
+        drawBuckets(points.size() / 2, colors, [this, &points](size_t i) {
+                        const auto &p1 = points[2 * i];
+                        const auto &p2 = points[2 * i + 1];
+                        cairo_move_to(context(), p1.x() + 0.5, p1.y() + 0.5);
+                        cairo_line_to(context(), p2.x() + 0.5, p2.y() + 0.5);
+                }, false);
+}
+
+void RkCairoGraphicsBackend::drawRects(const std::vector<RkRect> &rects,
+                                       const std::vector<RkColor> &colors)
+{
+        drawBuckets(rects.size(), colors, [this, &rects](size_t i) {
+                        const auto &rect = rects[i];
+                        cairo_rectangle(context(),
+                                        rect.left() + 0.5,
+                                        rect.top() + 0.5,
+                                        rect.width(),
+                                        rect.height());
+                }, false);
+}
+
+void RkCairoGraphicsBackend::fillRects(const std::vector<RkRect> &rects,
+                                       const std::vector<RkColor> &colors)
+{
+        drawBuckets(rects.size(), colors, [this, &rects](size_t i) {
+                        const auto &rect = rects[i];
+                        cairo_rectangle(context(), rect.left(), rect.top(), rect.width(), rect.height());
+                }, true);
+}
+
+void RkCairoGraphicsBackend::drawPoints(const std::vector<RkPoint> &points,
+                                        const std::vector<RkColor> &colors)
+{
+        // A point is a square of the pen width.
+        auto size = cairo_get_line_width(context());
+        drawBuckets(points.size(), colors, [this, &points, size](size_t i) {
+                        const auto &point = points[i];
+                        cairo_rectangle(context(),
+                                        point.x() + 0.5 - size / 2,
+                                        point.y() + 0.5 - size / 2,
+                                        size,
+                                        size);
+                }, true);
+}
+
 void RkCairoGraphicsBackend::applyAlpha(int alpha)
 {
         cairo_paint_with_alpha(context(), (float) alpha / 255);
@@ -204,6 +480,35 @@ void RkCairoGraphicsBackend::rotate(rk_real angle)
         cairo_rotate(context(), angle);
 }
 
+void RkCairoGraphicsBackend::save()
+{
+        cairo_save(context());
+}
+
+void RkCairoGraphicsBackend::restore()
+{
+        cairo_restore(context());
+}
+
+void RkCairoGraphicsBackend::clip(const std::vector<RkRect> &rects)
+{
+        cairo_new_path(context());
+        for (const auto &rect: rects)
+                cairo_rectangle(context(), rect.left(), rect.top(), rect.width(), rect.height());
+        cairo_clip(context());
+}
+
+RkRect RkCairoGraphicsBackend::clipBounds() const
+{
+        double x1, y1, x2, y2;
+        cairo_clip_extents(context(), &x1, &y1, &x2, &y2);
+        // Unbounded surfaces have no clip, keep the numbers in the int range.
+        static constexpr double limit = 1 << 28;
+        auto toInt = [](double value) { return static_cast<int>(std::clamp(value, -limit, limit)); };
+        return RkRect(RkPoint(toInt(floor(x1)), toInt(floor(y1))),
+                      RkPoint(toInt(ceil(x2)), toInt(ceil(y2))));
+}
+
 int RkCairoGraphicsBackend::getTextWidth(const std::string &text) const
 {
         if (text.empty())
@@ -213,3 +518,13 @@ int RkCairoGraphicsBackend::getTextWidth(const std::string &text) const
         cairo_text_extents (context(), text.data(), &extents);
         return extents.x_advance;
 }
+
+int RkCairoGraphicsBackend::getTextWidth(std::string_view text) const
+{
+        if (text.empty())
+                return 0;
+
+        cairo_text_extents_t extents;
+        cairo_text_extents (context(), terminated(text), &extents);
+        return extents.x_advance;
+}
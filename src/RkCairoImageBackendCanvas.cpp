@@ -1,13 +1,23 @@
 
 #include "RkCairoImageBackendCanvas.h"
 #include "RkCanvasInfo.h"
+#include "RkImageDecoder.h"
 #include "RkLog.h"
+#include "RkPixelOps.h"
+
+#include <algorithm>
 
 RkCairoImageBackendCanvas::RkCairoImageBackendCanvas(const RkSize &size,
                                                      RkImage::Format format,
-                                                     const unsigned char *data)
+                                                     const unsigned char *data,
+                                                     bool borrowData,
+                                                     int dataStride)
         : canvasInfo{nullptr}
+        , borrowedData{nullptr}
         , imageSize{size}
+        , imageFormat{format}
+        , imageStride{0}
+        , encodedData{nullptr}
 {
 #ifdef RK_OS_WIN
 #elif RK_OS_MAC
@@ -15,20 +25,99 @@ RkCairoImageBackendCanvas::RkCairoImageBackendCanvas(const RkSize &size,
         auto cairoFormat = toCairoFormat(format);
         if (cairoFormat != CAIRO_FORMAT_INVALID && imageSize.width() > 0 && imageSize.height() > 0) {
                 canvasInfo = std::make_unique<RkCanvasInfo>();
-                auto stride = cairo_format_stride_for_width(cairoFormat, imageSize.width());
-                if (data == nullptr)
-                        imageData = std::vector<unsigned char>(imageSize.width() * imageSize.height() * pixelLength(format), 0);
-                else
-                        imageData.assign(data, data + imageSize.width() * imageSize.height() * pixelLength(format));
-                canvasInfo->cairo_surface = cairo_image_surface_create_for_data(imageData.data(),
-                                                                                CAIRO_FORMAT_ARGB32,
+                imageStride = cairo_format_stride_for_width(cairoFormat, imageSize.width());
+                // By default the data rows are tightly packed, Cairo may need padded rows (A8).
+                auto rowLength = imageSize.width() * pixelLength(format);
+                auto srcStride = dataStride > 0 ? dataStride : rowLength;
+                if (data != nullptr && borrowData && srcStride == imageStride) {
+                        borrowedData = data;
+                } else {
+                        imageData = std::vector<unsigned char>(imageStride * imageSize.height(), 0);
+                        for (int y = 0; data != nullptr && y < imageSize.height(); y++)
+                                std::copy(data + y * srcStride,
+                                          data + y * srcStride + rowLength,
+                                          imageData.data() + y * imageStride);
+                }
+                auto pixels = borrowedData ? const_cast<unsigned char*>(borrowedData) : imageData.data();
+                canvasInfo->cairo_surface = cairo_image_surface_create_for_data(pixels,
+                                                                                cairoFormat,
                                                                                 imageSize.width(),
                                                                                 imageSize.height(),
-                                                                                stride);
+                                                                                imageStride);
         }
 #endif
 }
 
+RkCairoImageBackendCanvas::RkCairoImageBackendCanvas(const std::string &file)
+        : canvasInfo{nullptr}
+        , borrowedData{nullptr}
+        , imageFormat{RkImage::Format::ARGB32}
+        , imageStride{0}
+        , encodedData{nullptr}
+{
+        auto image = cairo_image_surface_create_from_png(file.c_str());
+        if (cairo_surface_status(image) != CAIRO_STATUS_SUCCESS) {
+                RK_LOG_ERROR("can't load image: " << file);
+                cairo_surface_destroy(image);
+                return;
+        }
+
+        // Cairo decodes PNG files as ARGB32, or RGB24 with the unused byte set to 0xff.
+        cairo_surface_flush(image);
+        imageSize = RkSize(cairo_image_surface_get_width(image), cairo_image_surface_get_height(image));
+        auto stride = cairo_image_surface_get_stride(image);
+        auto rowLength = imageSize.width() * 4;
+        imageStride = rowLength;
+        imageData.resize(rowLength * imageSize.height());
+        const unsigned char *pixels = cairo_image_surface_get_data(image);
+        for (int y = 0; y < imageSize.height(); y++)
+                std::copy(pixels + y * stride, pixels + y * stride + rowLength, imageData.data() + y * rowLength);
+        cairo_surface_destroy(image);
+
+        canvasInfo = std::make_unique<RkCanvasInfo>();
+        canvasInfo->cairo_surface = cairo_image_surface_create_for_data(imageData.data(),
+                                                                        CAIRO_FORMAT_ARGB32,
+                                                                        imageSize.width(),
+                                                                        imageSize.height(),
+                                                                        rowLength);
+}
+
+RkCairoImageBackendCanvas::RkCairoImageBackendCanvas(const RkCairoImageBackendCanvas &other)
+        : canvasInfo{nullptr}
+        , borrowedData{nullptr}
+        , imageSize{other.imageSize}
+        , imageFormat{other.imageFormat}
+        , imageStride{other.imageStride}
+        , encodedData{nullptr}
+{
+        if (other.isNull())
+                return;
+
+        auto pixels = other.data();
+        imageData.assign(pixels, pixels + imageStride * imageSize.height());
+        canvasInfo = std::make_unique<RkCanvasInfo>();
+        canvasInfo->cairo_surface = cairo_image_surface_create_for_data(imageData.data(),
+                                                                        toCairoFormat(imageFormat),
+                                                                        imageSize.width(),
+                                                                        imageSize.height(),
+                                                                        imageStride);
+}
+
+RkCairoImageBackendCanvas::RkCairoImageBackendCanvas(const unsigned char *resource)
+        : canvasInfo{nullptr}
+        , borrowedData{nullptr}
+        , imageFormat{RkImage::Format::ARGB32}
+        , imageStride{0}
+        , encodedData{nullptr}
+{
+        if (!RkImageDecoder::imageInfo(resource, imageSize, imageFormat)) {
+                RK_LOG_ERROR("invalid image resource");
+                return;
+        }
+        encodedData = resource;
+        imageStride = cairo_format_stride_for_width(toCairoFormat(imageFormat), imageSize.width());
+}
+
 RkCairoImageBackendCanvas::~RkCairoImageBackendCanvas()
 {
         if (canvasInfo)
@@ -41,6 +130,7 @@ cairo_format_t RkCairoImageBackendCanvas::toCairoFormat(RkImage::Format format)
         {
         case RkImage::Format::ARGB32: return CAIRO_FORMAT_ARGB32;
         case RkImage::Format::RGB32:  return CAIRO_FORMAT_RGB24;
+        case RkImage::Format::A8:     return CAIRO_FORMAT_A8;
         default: return CAIRO_FORMAT_INVALID;
         }
 }
@@ -62,31 +152,169 @@ const RkSize& RkCairoImageBackendCanvas::size() const
 
 bool RkCairoImageBackendCanvas::isNull() const
 {
-        return canvasInfo == nullptr;
+        // The encoded canvas gets its surface in decode(), maybe on another
+        // thread. canvasInfo is read only for the other canvases, where it
+        // is set once by the constructor.
+        return encodedData == nullptr && canvasInfo == nullptr;
+}
+
+int RkCairoImageBackendCanvas::stride() const
+{
+        return imageStride;
+}
+
+bool RkCairoImageBackendCanvas::isBorrowed() const
+{
+        return borrowedData != nullptr;
+}
+
+bool RkCairoImageBackendCanvas::isDecoded() const
+{
+        return encodedData == nullptr || decodeDone.load(std::memory_order_acquire);
+}
+
+void RkCairoImageBackendCanvas::createSurface(unsigned char *pixels) const
+{
+        canvasInfo = std::make_unique<RkCanvasInfo>();
+        canvasInfo->cairo_surface = cairo_image_surface_create_for_data(pixels,
+                                                                        toCairoFormat(imageFormat),
+                                                                        imageSize.width(),
+                                                                        imageSize.height(),
+                                                                        imageStride);
+}
+
+void RkCairoImageBackendCanvas::decode() const
+{
+        if (encodedData == nullptr)
+                return;
+
+        // Images are shared between threads (e.g. preloaded), decode only once.
+        std::call_once(decodeFlag, [this] {
+                        imageData.assign(imageStride * imageSize.height(), 0);
+                        if (!RkImageDecoder::decode(encodedData, imageData.data(), imageStride))
+                                RK_LOG_ERROR("can't decode image resource");
+                        createSurface(imageData.data());
+                        decodeDone.store(true, std::memory_order_release);
+                });
 }
 
 unsigned char* RkCairoImageBackendCanvas::data()
 {
+        decode();
+        if (canvasInfo)
+                cairo_surface_flush(canvasInfo->cairo_surface);
+        if (borrowedData)
+                return const_cast<unsigned char*>(borrowedData);
+        return imageData.data();
+}
+
+const unsigned char* RkCairoImageBackendCanvas::data() const
+{
+        decode();
+        if (canvasInfo)
+                cairo_surface_flush(canvasInfo->cairo_surface);
+        if (borrowedData)
+                return borrowedData;
         return imageData.data();
 }
 
 std::vector<unsigned char> RkCairoImageBackendCanvas::dataCopy() const
 {
+        decode();
+        if (borrowedData)
+                return std::vector<unsigned char>(borrowedData, borrowedData + imageStride * imageSize.height());
         return imageData;
 }
 
 RkCanvasInfo* RkCairoImageBackendCanvas::getCanvasInfo() const
 {
+        decode();
         return canvasInfo.get();
 }
 
 void RkCairoImageBackendCanvas::fill(const RkColor &color)
 {
-        unsigned char *data = imageData.data();
-        for (decltype(imageData.size()) i = 0; i < imageData.size() - 4; i += 4) {
-                *(data + i)     = color.red();
-                *(data + i + 1) = color.green();
-                *(data + i + 2) = color.blue();
-                *(data + i + 3) = color.alpha();
+        fill(color, RkRect(RkPoint(0, 0), imageSize));
+}
+
+void RkCairoImageBackendCanvas::fill(const RkColor &color, const RkRect &rect)
+{
+        if (isNull())
+                return;
+
+        auto x = std::max(rect.left(), 0);
+        auto y = std::max(rect.top(), 0);
+        auto width = std::min(rect.left() + rect.width(), imageSize.width()) - x;
+        auto height = std::min(rect.top() + rect.height(), imageSize.height()) - y;
+        if (width < 1 || height < 1)
+                return;
+
+        decode();
+        cairo_surface_flush(canvasInfo->cairo_surface);
+        if (imageFormat == RkImage::Format::A8) {
+                for (int row = y; row < y + height; row++)
+                        std::fill_n(data() + row * imageStride + x, width, static_cast<unsigned char>(color.alpha()));
+        } else {
+                auto pixel = RkPixelOps::pixel(color);
+                if (imageFormat == RkImage::Format::RGB32)
+                        pixel = RkPixelOps::pixel(RkColor(color.red(), color.green(), color.blue()));
+                RkPixelOps::fillRect(data(), imageStride, x, y, width, height, pixel);
         }
+        cairo_surface_mark_dirty_rectangle(canvasInfo->cairo_surface, x, y, width, height);
+}
+
+void RkCairoImageBackendCanvas::scroll(int dx, int dy)
+{
+        if (isNull() || (dx == 0 && dy == 0))
+                return;
+
+        decode();
+        cairo_surface_flush(canvasInfo->cairo_surface);
+        RkPixelOps::scroll(data(), imageStride, imageSize.width(), imageSize.height(),
+                           pixelLength(imageFormat), dx, dy);
+        cairo_surface_mark_dirty(canvasInfo->cairo_surface);
+}
+
+void RkCairoImageBackendCanvas::applyAlpha(int alpha)
+{
+        if (isNull() || imageFormat == RkImage::Format::RGB32)
+                return;
+
+        decode();
+        cairo_surface_flush(canvasInfo->cairo_surface);
+        auto pixels = data();
+        if (imageFormat == RkImage::Format::A8) {
+                auto a = std::clamp(alpha, 0, 255);
+                for (int y = 0; y < imageSize.height(); y++) {
+                        auto row = pixels + y * imageStride;
+                        for (int x = 0; x < imageSize.width(); x++)
+                                row[x] = (row[x] * a + 127) / 255;
+                }
+        } else {
+                for (int y = 0; y < imageSize.height(); y++)
+                        RkPixelOps::applyAlpha(reinterpret_cast<uint32_t*>(pixels + y * imageStride),
+                                               imageSize.width(),
+                                               alpha);
+        }
+        cairo_surface_mark_dirty(canvasInfo->cairo_surface);
+}
+
+void RkCairoImageBackendCanvas::paste(const RkCairoImageBackendCanvas &image, int x, int y)
+{
+        if (isNull() || image.isNull() || image.imageFormat != imageFormat)
+                return;
+
+        auto width = std::min(image.size().width(), imageSize.width() - x);
+        auto height = std::min(image.size().height(), imageSize.height() - y);
+        if (x < 0 || y < 0 || width < 1 || height < 1)
+                return;
+
+        decode();
+        cairo_surface_flush(canvasInfo->cairo_surface);
+        auto rowLength = width * pixelLength(imageFormat);
+        auto src = image.data();
+        auto dst = data() + y * imageStride + x * pixelLength(imageFormat);
+        for (int row = 0; row < height; row++)
+                std::copy(src + row * image.stride(), src + row * image.stride() + rowLength, dst + row * imageStride);
+        cairo_surface_mark_dirty_rectangle(canvasInfo->cairo_surface, x, y, width, height);
 }
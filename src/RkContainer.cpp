@@ -23,6 +23,9 @@
 
 #include "RkContainer.h"
 #include "RkContainerWidgetItem.h"
+#include "RkLayoutSpace.h"
+
+#include <algorithm>
 
 RkContainer::RkContainer(RkWidget *parent, Rk::Orientation orientation)
 	: RkContainerItem(parent, ItemType::ItemContainer)
@@ -33,38 +36,73 @@ RkContainer::RkContainer(RkWidget *parent, Rk::Orientation orientation)
 	setSize(parent->size());
 }
 
-void RkContainer::addContainer(RkContainer *container, Rk::Alignment align)
+void RkContainer::addContainer(RkContainerItem *container, Rk::Alignment align, int stretch)
 {
         container->setAlignment(align);
+        container->setStretch(stretch);
+        container->setSizeHint(container->size());
+        container->setParentContainer(this);
 	containerItems.push_back(container);
-	update();
+	invalidate();
 }
 
-void RkContainer::addWidget(RkWidget *widget, Rk::Alignment align)
+void RkContainer::addWidget(RkWidget *widget, Rk::Alignment align, int stretch)
 {
         auto item = new RkContainerWidgetItem(widget, align);
+        item->setStretch(stretch);
+        item->setSizeHint(widget->size());
 	containerItems.push_back(item);
-	update();
+	invalidate();
 }
 
 void RkContainer::removeWidget(RkWidget *widget)
 {
+        auto item = widgetItem(widget);
+        if (!item)
+                return;
+        containerItems.erase(std::find(containerItems.begin(), containerItems.end(), item));
+        delete item;
+        invalidate();
 }
 
-void RkContainer::addSpace(int space, Rk::Alignment align)
+void RkContainer::setStretch(RkWidget *widget, int stretch)
+{
+        auto item = widgetItem(widget);
+        if (item && item->stretch() != stretch) {
+                item->setStretch(stretch);
+                invalidate();
+        }
+}
+
+RkContainerItem* RkContainer::widgetItem(RkWidget *widget) const
+{
+        for (const auto &item: containerItems) {
+                auto containerWidgetItem = dynamic_cast<RkContainerWidgetItem*>(item);
+                if (containerWidgetItem && containerWidgetItem->widget() == widget)
+                        return item;
+        }
+        return nullptr;
+}
+
+void RkContainer::addSpace(int space, Rk::Alignment align, int stretch)
 {
         auto item = new RkContainerItem(this, RkContainerItem::ItemType::ItemSpace, align);
         item->setSize({space, space});
+        item->setSizeHint({space, space});
+        item->setStretch(stretch);
         containerItems.push_back(item);
-	update();
+	invalidate();
 }
 
 void RkContainer::removeAt(size_t index)
 {
         if (index < containerItems.size()) {
-                if (containerItems[index]->parent() == this)
-                        delete containerItems[index];
+                auto item = containerItems[index];
+                item->setParentContainer(nullptr);
+                if (item->parent() == this)
+                        delete item;
                 containerItems.erase(containerItems.begin() + index);
+                invalidate();
         }
 }
 
@@ -75,29 +113,73 @@ RkContainerItem* RkContainer::at(size_t index) const
         return nullptr;
 }
 
-void RkContainer::update()
+/**
+ * Two passes over the items: the first measures the lengths along the
+ * orientation and shares the free space between the stretched items,
+ * the second places the items.
+ */
+void RkContainer::layout()
 {
+        auto horizontal = orientation() == Rk::Orientation::Horizontal;
+        auto mainLength = [horizontal](const RkSize &size) {
+                return horizontal ? size.width() : size.height();
+        };
+
+        std::vector<RkLayoutSlot> slots;
+        slots.reserve(containerItems.size());
+        for (const auto &item: containerItems) {
+                if (!hiddenTakesPlace() && item->isHidden())
+                        continue;
+                RkLayoutSlot slot;
+                slot.stretch = item->stretch();
+                slot.length = mainLength(slot.stretch > 0 ? item->sizeHint() : item->size());
+                slot.minimum = mainLength(item->minimumSize());
+                slot.maximum = mainLength(item->maximumSize());
+                slots.push_back(slot);
+        }
+        auto space = mainLength(size());
+        if (!slots.empty())
+                space -= static_cast<int>(itemSpacing * (slots.size() - 1));
+        RkLayoutSpace::distribute(slots, space);
+
 	int posLeft = initPosition(Rk::Alignment::AlignLeft);
 	int posRight = initPosition(Rk::Alignment::AlignRight);
+        auto slot = slots.cbegin();
 	for (const auto &item: containerItems) {
-                if (!hiddenTakesPlace() && item->isHidden())
+                if (!hiddenTakesPlace() && item->isHidden()) {
+                        item->activate();
                         continue;
+                }
+
+                auto length = (slot++)->length;
+                if (item->stretch() > 0) {
+                        auto itemSize = horizontal ? RkSize(length, item->height())
+                                : RkSize(item->width(), length);
+                        if (item->size() != itemSize)
+                                item->setSize(itemSize);
+                }
+
                 auto align = item->alignment();
-                if (orientation() == Rk::Orientation::Horizontal) {
-                        (align == Rk::Alignment::AlignLeft || align == Rk::Alignment::AlignTop) ?
-                                item->setX(posLeft) : item->setX(posRight - item->width());
-                        item->setY(y() + (height() - item->height()) / 2);
+                RkPoint pos;
+                if (horizontal) {
+                        pos.setX((align == Rk::Alignment::AlignLeft || align == Rk::Alignment::AlignTop) ?
+                                 posLeft : posRight - length);
+                        pos.setY(y() + (height() - item->height()) / 2);
                 } else {
-                        (align == Rk::Alignment::AlignLeft || align == Rk::Alignment::AlignTop) ?
-                                item->setY(posLeft) : item->setY(posRight - item->height());
-                        item->setX(x() + (width() - item->width()) / 2);
+                        pos.setY((align == Rk::Alignment::AlignLeft || align == Rk::Alignment::AlignTop) ?
+                                 posLeft : posRight - length);
+                        pos.setX(x() + (width() - item->width()) / 2);
                 }
 
-                auto w = (orientation() == Rk::Orientation::Horizontal) ? item->width() : item->height();
+                // Move only the items that changed, each with a single request.
+                if (item->position() != pos)
+                        item->setPosition(pos);
+                item->activate();
+
                 if (align == Rk::Alignment::AlignLeft || align == Rk::Alignment::AlignTop)
-                        posLeft += w + itemSpacing;
+                        posLeft += length + itemSpacing;
                 else
-                        posRight -= w + itemSpacing;
+                        posRight -= length + itemSpacing;
 	}
 }
 
@@ -121,6 +203,7 @@ int RkContainer::initPosition(Rk::Alignment alignment)
 void RkContainer::clear()
 {
         for (auto &item: containerItems) {
+                item->setParentContainer(nullptr);
                 if (item->parent() == this)
                         delete item;
         }
@@ -135,43 +218,43 @@ Rk::Orientation RkContainer::orientation() const
 void RkContainer::setSize(const RkSize &size)
 {
         RkContainerItem::setSize(size);
-	update();
+	invalidate();
 }
 
 void RkContainer::setWidth(int width)
 {
 	RkContainerItem::setWidth(width);
-	update();
+	invalidate();
 }
 
 void RkContainer::setHeight(int height)
 {
 	RkContainerItem::setHeight(height);
-	update();
+	invalidate();
 }
 
 void RkContainer::setPosition(const RkPoint &position)
 {
         RkContainerItem::setPosition(position);
-	update();
+	invalidate();
 }
 
 void RkContainer::setX(int val)
 {
         RkContainerItem::setX(val);
-        update();
+        invalidate();
 }
 
 void RkContainer::setY(int val)
 {
         RkContainerItem::setY(val);
-        update();
+        invalidate();
 }
 
 void RkContainer::setSpacing(size_t space)
 {
 	itemSpacing = space;
-	update();
+	invalidate();
 }
 
 size_t RkContainer::spacing() const
@@ -182,7 +265,7 @@ size_t RkContainer::spacing() const
 void RkContainer::setHiddenTakesPlace(bool b)
 {
         isHiddenTakesPlace = b;
-        update();
+        invalidate();
 }
 
 bool RkContainer::hiddenTakesPlace() const
@@ -0,0 +1,64 @@
+/**
+ * File name: RkContainerItem.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkContainerItem.h"
+#include "RkEventQueue.h"
+#include "RkAction.h"
+
+void RkContainerItem::update()
+{
+        itemDirty = true;
+        activate();
+}
+
+void RkContainerItem::invalidate()
+{
+        if (itemDirty)
+                return;
+        itemDirty = true;
+
+        // The outer container lays out this one in its own pass.
+        if (parentItem && parentItem->isDirty())
+                return;
+
+        auto queue = eventQueue();
+        if (!queue) {
+                activate();
+                return;
+        }
+
+        auto act = std::make_unique<RkAction>(this);
+        act->setCallback([this](){
+                        if (!parentItem || !parentItem->isDirty())
+                                activate();
+                });
+        queue->postAction(std::move(act));
+}
+
+void RkContainerItem::activate()
+{
+        if (!itemDirty)
+                return;
+        itemDirty = false;
+        layout();
+}
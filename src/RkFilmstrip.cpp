@@ -0,0 +1,150 @@
+/**
+ * File name: RkFilmstrip.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkFilmstrip.h"
+#include "RkFilmstripImpl.h"
+#include "RkEventQueue.h"
+#include "RkEvent.h"
+#include "RkPainter.h"
+
+RkFilmstrip::RkFilmstrip(RkWidget *parent)
+        : RkWidget(parent, std::make_unique<RkFilmstrip::RkFilmstripImpl>(this, parent))
+        , impl_ptr{static_cast<RkFilmstrip::RkFilmstripImpl*>(o_ptr.get())}
+{
+}
+
+void RkFilmstrip::setImage(const RkImage &strip, int frames, Rk::Orientation orientation)
+{
+        setImage(RkImageRegion(strip), frames, orientation);
+}
+
+void RkFilmstrip::setImage(const RkImageRegion &strip, int frames, Rk::Orientation orientation)
+{
+        impl_ptr->setImage(strip, frames, orientation);
+        setSize(impl_ptr->frameSize());
+        update();
+}
+
+int RkFilmstrip::frames() const
+{
+        return impl_ptr->frames();
+}
+
+int RkFilmstrip::frame() const
+{
+        return impl_ptr->frame();
+}
+
+void RkFilmstrip::setRange(rk_real begin, rk_real end)
+{
+        impl_ptr->setRange(begin, end);
+        setValue(value());
+}
+
+rk_real RkFilmstrip::beginValue() const
+{
+        return impl_ptr->beginValue();
+}
+
+rk_real RkFilmstrip::endValue() const
+{
+        return impl_ptr->endValue();
+}
+
+rk_real RkFilmstrip::value() const
+{
+        return impl_ptr->value();
+}
+
+void RkFilmstrip::setValue(rk_real value)
+{
+        // Only the first value since the last repaint posts an update,
+        // the next ones just overwrite the value.
+        if (impl_ptr->setValue(value) && eventQueue()) {
+                auto act = std::make_unique<RkAction>(this);
+                act->setCallback([this](){
+                                if (impl_ptr->syncFrame())
+                                        update();
+                        });
+                eventQueue()->postAction(std::move(act));
+        }
+}
+
+void RkFilmstrip::setDragDistance(int distance)
+{
+        impl_ptr->setDragDistance(distance);
+}
+
+int RkFilmstrip::dragDistance() const
+{
+        return impl_ptr->dragDistance();
+}
+
+void RkFilmstrip::changeValue(rk_real value)
+{
+        auto oldValue = this->value();
+        impl_ptr->setValue(value);
+        if (impl_ptr->syncFrame())
+                update();
+        if (this->value() != oldValue)
+                action valueChanged(this->value());
+}
+
+void RkFilmstrip::mouseButtonPressEvent(RkMouseEvent *event)
+{
+        auto step = frames() > 1 ? (endValue() - beginValue()) / (frames() - 1) : 0;
+        switch (event->button())
+        {
+        case RkMouseEvent::ButtonType::Left:
+                impl_ptr->startDrag(event->y());
+                break;
+        case RkMouseEvent::ButtonType::WheelUp:
+                changeValue(value() + step);
+                break;
+        case RkMouseEvent::ButtonType::WheelDown:
+                changeValue(value() - step);
+                break;
+        default:
+                break;
+        }
+}
+
+void RkFilmstrip::mouseButtonReleaseEvent(RkMouseEvent *event)
+{
+        RK_UNUSED(event);
+        impl_ptr->stopDrag();
+}
+
+void RkFilmstrip::mouseMoveEvent(RkMouseEvent *event)
+{
+        if (impl_ptr->isDragging())
+                changeValue(impl_ptr->dragValue(event->y()));
+}
+
+void RkFilmstrip::paintEvent(RkPaintEvent *event)
+{
+        RK_UNUSED(event);
+        RkPainter painter(this);
+        painter.fillRect(rect(), background());
+        impl_ptr->drawFrame(painter);
+}
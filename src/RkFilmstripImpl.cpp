@@ -0,0 +1,172 @@
+/**
+ * File name: RkFilmstripImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkFilmstripImpl.h"
+#include "RkPainter.h"
+
+#include <algorithm>
+#include <cmath>
+
+RkFilmstrip::RkFilmstripImpl::RkFilmstripImpl(RkFilmstrip *interface, RkWidget *parent)
+    : RkWidgetImpl(static_cast<RkWidget*>(interface), parent)
+    , inf_ptr{interface}
+    , framesNumber{0}
+    , stripOrientation{Rk::Orientation::Vertical}
+    , beginVal{0}
+    , endVal{1}
+    , currentValue{0}
+    , updatePending{false}
+    , currentFrame{0}
+    , dragPixels{200}
+    , isDrag{false}
+    , dragStartY{0}
+    , dragStartValue{0}
+{
+}
+
+void RkFilmstrip::RkFilmstripImpl::setImage(const RkImageRegion &strip,
+                                            int frames,
+                                            Rk::Orientation orientation)
+{
+        stripRegion = strip;
+        framesNumber = std::max(frames, 0);
+        stripOrientation = orientation;
+        currentFrame = frameFromValue(value());
+}
+
+RkSize RkFilmstrip::RkFilmstripImpl::frameSize() const
+{
+        if (framesNumber < 1)
+                return RkSize();
+        if (stripOrientation == Rk::Orientation::Vertical)
+                return RkSize(stripRegion.size().width(), stripRegion.size().height() / framesNumber);
+        return RkSize(stripRegion.size().width() / framesNumber, stripRegion.size().height());
+}
+
+int RkFilmstrip::RkFilmstripImpl::frames() const
+{
+        return framesNumber;
+}
+
+int RkFilmstrip::RkFilmstripImpl::frame() const
+{
+        return currentFrame;
+}
+
+void RkFilmstrip::RkFilmstripImpl::setRange(rk_real begin, rk_real end)
+{
+        beginVal = begin;
+        endVal = end;
+}
+
+rk_real RkFilmstrip::RkFilmstripImpl::beginValue() const
+{
+        return beginVal;
+}
+
+rk_real RkFilmstrip::RkFilmstripImpl::endValue() const
+{
+        return endVal;
+}
+
+rk_real RkFilmstrip::RkFilmstripImpl::value() const
+{
+        return currentValue.load(std::memory_order_relaxed);
+}
+
+bool RkFilmstrip::RkFilmstripImpl::setValue(rk_real value)
+{
+        auto begin = beginValue();
+        auto end = endValue();
+        value = std::clamp(value, std::min(begin, end), std::max(begin, end));
+        currentValue.store(value, std::memory_order_release);
+        return !updatePending.exchange(true, std::memory_order_acq_rel);
+}
+
+bool RkFilmstrip::RkFilmstripImpl::syncFrame()
+{
+        // Pairs with setValue(): a value stored after this exchange posts a new update.
+        updatePending.exchange(false, std::memory_order_acq_rel);
+        auto frame = frameFromValue(currentValue.load(std::memory_order_acquire));
+        if (frame == currentFrame)
+                return false;
+        currentFrame = frame;
+        return true;
+}
+
+int RkFilmstrip::RkFilmstripImpl::frameFromValue(rk_real value) const
+{
+        auto range = endValue() - beginValue();
+        if (framesNumber < 1 || range == 0)
+                return 0;
+        auto frame = std::lround((value - beginValue()) / range * (framesNumber - 1));
+        return std::clamp(static_cast<int>(frame), 0, framesNumber - 1);
+}
+
+void RkFilmstrip::RkFilmstripImpl::setDragDistance(int distance)
+{
+        dragPixels = std::max(distance, 1);
+}
+
+int RkFilmstrip::RkFilmstripImpl::dragDistance() const
+{
+        return dragPixels;
+}
+
+void RkFilmstrip::RkFilmstripImpl::startDrag(int y)
+{
+        isDrag = true;
+        dragStartY = y;
+        dragStartValue = value();
+}
+
+void RkFilmstrip::RkFilmstripImpl::stopDrag()
+{
+        isDrag = false;
+}
+
+bool RkFilmstrip::RkFilmstripImpl::isDragging() const
+{
+        return isDrag;
+}
+
+rk_real RkFilmstrip::RkFilmstripImpl::dragValue(int y) const
+{
+        auto range = endValue() - beginValue();
+        return dragStartValue + range * static_cast<rk_real>(dragStartY - y) / dragPixels;
+}
+
+void RkFilmstrip::RkFilmstripImpl::drawFrame(RkPainter &painter)
+{
+        if (stripRegion.isNull() || framesNumber < 1)
+                return;
+
+        // Draw only the frame subrectangle of the strip.
+        auto size = frameSize();
+        auto rect = stripRegion.rect();
+        if (stripOrientation == Rk::Orientation::Vertical)
+                rect = RkRect(rect.left(), rect.top() + currentFrame * size.height(), size.width(), size.height());
+        else
+                rect = RkRect(rect.left() + currentFrame * size.width(), rect.top(), size.width(), size.height());
+        painter.drawImage(RkImageRegion(stripRegion.image(), rect), 0, 0);
+}
@@ -0,0 +1,273 @@
+/**
+ * File name: RkGridContainer.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkGridContainer.h"
+#include "RkContainerWidgetItem.h"
+#include "RkLayoutSpace.h"
+
+#include <algorithm>
+
+RkGridContainer::RkGridContainer(RkWidget *parent)
+        : RkContainerItem(parent, ItemType::ItemContainer)
+        , gridRows{0}
+        , gridColumns{0}
+        , gridSpacing{0}
+{
+        if (parent)
+                setSize(parent->size());
+}
+
+void RkGridContainer::addWidget(RkWidget *widget, int row, int column, int rowSpan, int columnSpan)
+{
+        auto item = new RkContainerWidgetItem(widget);
+        item->setSizeHint(widget->size());
+        addCell(item, row, column, rowSpan, columnSpan);
+}
+
+void RkGridContainer::addContainer(RkContainerItem *container, int row, int column, int rowSpan, int columnSpan)
+{
+        container->setSizeHint(container->size());
+        container->setParentContainer(this);
+        addCell(container, row, column, rowSpan, columnSpan);
+}
+
+void RkGridContainer::addCell(RkContainerItem *item, int row, int column, int rowSpan, int columnSpan)
+{
+        Cell cell;
+        cell.item = item;
+        cell.row = std::max(row, 0);
+        cell.column = std::max(column, 0);
+        cell.rowSpan = std::max(rowSpan, 1);
+        cell.columnSpan = std::max(columnSpan, 1);
+        gridCells.push_back(cell);
+        gridRows = std::max(gridRows, cell.row + cell.rowSpan);
+        gridColumns = std::max(gridColumns, cell.column + cell.columnSpan);
+        invalidate();
+}
+
+void RkGridContainer::removeWidget(RkWidget *widget)
+{
+        auto res = std::find_if(gridCells.begin(), gridCells.end(), [widget](const Cell &cell) {
+                        auto item = dynamic_cast<RkContainerWidgetItem*>(cell.item);
+                        return item && item->widget() == widget;
+                });
+        if (res == gridCells.end())
+                return;
+        delete res->item;
+        gridCells.erase(res);
+        updateGridSize();
+        invalidate();
+}
+
+void RkGridContainer::clear()
+{
+        for (auto &cell: gridCells) {
+                cell.item->setParentContainer(nullptr);
+                if (dynamic_cast<RkContainerWidgetItem*>(cell.item))
+                        delete cell.item;
+        }
+        gridCells.clear();
+        updateGridSize();
+}
+
+void RkGridContainer::updateGridSize()
+{
+        gridRows = gridColumns = 0;
+        for (const auto &cell: gridCells) {
+                gridRows = std::max(gridRows, cell.row + cell.rowSpan);
+                gridColumns = std::max(gridColumns, cell.column + cell.columnSpan);
+        }
+}
+
+int RkGridContainer::rows() const
+{
+        return gridRows;
+}
+
+int RkGridContainer::columns() const
+{
+        return gridColumns;
+}
+
+void RkGridContainer::setRowStretch(int row, int stretch)
+{
+        if (row < 0)
+                return;
+        if (static_cast<size_t>(row) >= rowStretches.size())
+                rowStretches.resize(row + 1, 0);
+        rowStretches[row] = stretch;
+        invalidate();
+}
+
+int RkGridContainer::rowStretch(int row) const
+{
+        if (row >= 0 && static_cast<size_t>(row) < rowStretches.size())
+                return rowStretches[row];
+        return 0;
+}
+
+void RkGridContainer::setColumnStretch(int column, int stretch)
+{
+        if (column < 0)
+                return;
+        if (static_cast<size_t>(column) >= columnStretches.size())
+                columnStretches.resize(column + 1, 0);
+        columnStretches[column] = stretch;
+        invalidate();
+}
+
+int RkGridContainer::columnStretch(int column) const
+{
+        if (column >= 0 && static_cast<size_t>(column) < columnStretches.size())
+                return columnStretches[column];
+        return 0;
+}
+
+void RkGridContainer::setSpacing(int space)
+{
+        gridSpacing = std::max(space, 0);
+        invalidate();
+}
+
+int RkGridContainer::spacing() const
+{
+        return gridSpacing;
+}
+
+/**
+ * The measure pass sizes the rows and the columns from the size hints of
+ * the items, first the items in a single cell and then the spanning ones,
+ * and shares the free space between the stretched rows and columns. The
+ * arrange pass places each item in its cell. Both passes are linear in
+ * the number of items and cells.
+ */
+void RkGridContainer::layout()
+{
+        auto measure = [this](bool horizontal, int number, int space) {
+                std::vector<RkLayoutSlot> slots(number);
+                for (decltype(slots.size()) i = 0; i < slots.size(); i++)
+                        slots[i].stretch = horizontal ? columnStretch(i) : rowStretch(i);
+
+                for (const auto &cell: gridCells) {
+                        auto span = horizontal ? cell.columnSpan : cell.rowSpan;
+                        if (span != 1 || cell.item->isHidden())
+                                continue;
+                        auto &slot = slots[horizontal ? cell.column : cell.row];
+                        auto hint = cell.item->sizeHint();
+                        auto minimum = cell.item->minimumSize();
+                        slot.length = std::max(slot.length, horizontal ? hint.width() : hint.height());
+                        slot.minimum = std::max(slot.minimum, horizontal ? minimum.width() : minimum.height());
+                }
+
+                for (const auto &cell: gridCells) {
+                        auto span = horizontal ? cell.columnSpan : cell.rowSpan;
+                        if (span == 1 || cell.item->isHidden())
+                                continue;
+                        auto first = horizontal ? cell.column : cell.row;
+                        auto hint = horizontal ? cell.item->sizeHint().width() : cell.item->sizeHint().height();
+                        auto length = gridSpacing * (span - 1);
+                        for (auto i = first; i < first + span; i++)
+                                length += slots[i].length;
+                        if (length < hint) {
+                                auto need = hint - length;
+                                for (auto i = first; i < first + span; i++)
+                                        slots[i].length += need / span + (i == first + span - 1 ? need % span : 0);
+                        }
+                }
+
+                for (auto &slot: slots)
+                        slot.length = std::max(slot.length, slot.minimum);
+                RkLayoutSpace::distribute(slots, space - gridSpacing * std::max(number - 1, 0));
+
+                // The slots positions, one more for the end of the last slot.
+                std::vector<int> positions(number + 1);
+                positions[0] = horizontal ? x() : y();
+                for (int i = 0; i < number; i++)
+                        positions[i + 1] = positions[i] + slots[i].length + gridSpacing;
+                return positions;
+        };
+
+        auto columnsPositions = measure(true, columns(), width());
+        auto rowsPositions = measure(false, rows(), height());
+
+        for (const auto &cell: gridCells) {
+                if (cell.item->isHidden()) {
+                        cell.item->activate();
+                        continue;
+                }
+
+                RkRect rect(columnsPositions[cell.column],
+                            rowsPositions[cell.row],
+                            columnsPositions[cell.column + cell.columnSpan] - columnsPositions[cell.column] - gridSpacing,
+                            rowsPositions[cell.row + cell.rowSpan] - rowsPositions[cell.row] - gridSpacing);
+                auto minimum = cell.item->minimumSize();
+                auto maximum = cell.item->maximumSize();
+                RkSize itemSize(std::clamp(rect.width(), minimum.width(), std::max(maximum.width(), minimum.width())),
+                                std::clamp(rect.height(), minimum.height(), std::max(maximum.height(), minimum.height())));
+                RkPoint pos(rect.left() + (rect.width() - itemSize.width()) / 2,
+                            rect.top() + (rect.height() - itemSize.height()) / 2);
+
+                // Apply only the geometry that changed.
+                if (cell.item->size() != itemSize)
+                        cell.item->setSize(itemSize);
+                if (cell.item->position() != pos)
+                        cell.item->setPosition(pos);
+                cell.item->activate();
+        }
+}
+
+void RkGridContainer::setSize(const RkSize &size)
+{
+        RkContainerItem::setSize(size);
+        invalidate();
+}
+
+void RkGridContainer::setWidth(int width)
+{
+        RkContainerItem::setWidth(width);
+        invalidate();
+}
+
+void RkGridContainer::setHeight(int height)
+{
+        RkContainerItem::setHeight(height);
+        invalidate();
+}
+
+void RkGridContainer::setPosition(const RkPoint &position)
+{
+        RkContainerItem::setPosition(position);
+        invalidate();
+}
+
+void RkGridContainer::setX(int val)
+{
+        RkContainerItem::setX(val);
+        invalidate();
+}
+
+void RkGridContainer::setY(int val)
+{
+        RkContainerItem::setY(val);
+        invalidate();
+}
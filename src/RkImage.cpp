@@ -24,6 +24,8 @@
 #include "RkImage.h"
 #include "RkImageImpl.h"
 
+#include <utility>
+
 RkImage::RkImage()
         : o_ptr{std::make_unique<RkImageImpl>(this, 0, 0, nullptr)}
 {
@@ -49,10 +51,14 @@ RkImage::RkImage(std::unique_ptr<RkImageImpl> impl)
 {
 }
 
-RkImage::RkImage(const RkImage &image) :
-        o_ptr{std::make_unique<RkImageImpl>(this, 0, 0, nullptr)}
+RkImage::RkImage(const RkImage &image)
+        : o_ptr{std::make_unique<RkImageImpl>(this, *image.o_ptr)}
+{
+}
+
+RkImage::RkImage(RkImage &&image)
+        : o_ptr{std::make_unique<RkImageImpl>(this, std::move(*image.o_ptr))}
 {
-        o_ptr->createImage({image.width(), image.height()}, image.format(), image.data());
 }
 
 RkImage::~RkImage()
@@ -61,25 +67,68 @@ RkImage::~RkImage()
 
 RkImage& RkImage::operator=(const RkImage &other)
 {
-        o_ptr->createImage({other.width(), other.height()}, other.format(), other.data());
+        if (this != &other)
+                o_ptr->share(*other.o_ptr);
         return *this;
 }
 
+RkImage& RkImage::operator=(RkImage &&other)
+{
+        if (this != &other)
+                o_ptr->take(*other.o_ptr);
+        return *this;
+}
+
+bool operator==(const RkImage &im1, const RkImage &im2)
+{
+        return im1.o_ptr->isEqual(*im2.o_ptr);
+}
+
+bool operator!=(const RkImage &im1, const RkImage &im2)
+{
+        return !(im1 == im2);
+}
+
 void RkImage::fill(const RkColor &color)
 {
         o_ptr->fill(color);
 }
 
+void RkImage::fill(const RkColor &color, const RkRect &rect)
+{
+        o_ptr->fill(color, rect);
+}
+
+void RkImage::scroll(int dx, int dy)
+{
+        o_ptr->scroll(dx, dy);
+}
+
+void RkImage::applyAlpha(int alpha)
+{
+        o_ptr->applyAlpha(alpha);
+}
+
 const RkCanvasInfo* RkImage::getCanvasInfo() const
 {
         return o_ptr->getCanvasInfo();
 }
 
-unsigned char* RkImage::data() const
+void RkImage::beginPaint()
+{
+        o_ptr->detach();
+}
+
+unsigned char* RkImage::data()
 {
         return o_ptr->data();
 }
 
+const unsigned char* RkImage::data() const
+{
+        return o_ptr->constData();
+}
+
 std::vector<unsigned char> RkImage::dataCopy() const
 {
         return o_ptr->dataCopy();
@@ -100,6 +149,11 @@ int RkImage::height() const
         return o_ptr->height();
 }
 
+int RkImage::stride() const
+{
+        return o_ptr->stride();
+}
+
 RkSize RkImage::size() const
 {
         return o_ptr->size();
@@ -109,3 +163,18 @@ bool RkImage::isNull() const
 {
         return o_ptr->isNull();
 }
+
+void RkImage::setVariant(double scale, const RkImage &image)
+{
+        o_ptr->setVariant(scale, image);
+}
+
+RkImage RkImage::variant(double scale) const
+{
+        return o_ptr->variant(scale);
+}
+
+bool RkImage::hasVariants() const
+{
+        return o_ptr->hasVariants();
+}
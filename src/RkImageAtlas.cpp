@@ -0,0 +1,89 @@
+/**
+ * File name: RkImageAtlas.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkImageAtlas.h"
+#include "RkImageAtlasImpl.h"
+#include "RkImageImpl.h"
+
+RkImageAtlas::RkImageAtlas(const RkSize &size, RkImage::Format format)
+        : o_ptr{std::make_unique<RkImageAtlasImpl>(this, RkImage(size, nullptr, format))}
+{
+}
+
+RkImageAtlas::RkImageAtlas(const RkImage &sheet)
+        : o_ptr{std::make_unique<RkImageAtlasImpl>(this, sheet)}
+{
+        // The sheet is already full, the regions are set with setRegion().
+        RkRect rect;
+        o_ptr->allocate(RkSize(sheet.width(), sheet.height()), rect);
+}
+
+RkImageAtlas::~RkImageAtlas()
+{
+}
+
+RkImageRegion RkImageAtlas::add(const RkImage &image)
+{
+        RkRect rect;
+        if (image.isNull() || image.format() != o_ptr->image().format()
+            || !o_ptr->allocate(image.size(), rect))
+                return RkImageRegion();
+
+        // The allocated area is not used by any other region, no need to
+        // detach the atlas from the images shared with the regions. The
+        // copies given out by image() are detached, they must not change.
+        auto &sheet = o_ptr->image();
+        if (o_ptr->takeImageShared())
+                sheet.o_ptr->detach();
+        sheet.o_ptr->paste(*image.o_ptr, rect.left(), rect.top());
+        return RkImageRegion(o_ptr->image(), rect);
+}
+
+RkImageRegion RkImageAtlas::add(const std::string &name, const RkImage &image)
+{
+        auto region = add(image);
+        if (!region.isNull())
+                o_ptr->setRegion(name, region.rect());
+        return region;
+}
+
+void RkImageAtlas::setRegion(const std::string &name, const RkRect &rect)
+{
+        o_ptr->setRegion(name, rect);
+}
+
+RkImageRegion RkImageAtlas::region(const std::string &name) const
+{
+        return region(o_ptr->region(name));
+}
+
+RkImageRegion RkImageAtlas::region(const RkRect &rect) const
+{
+        return RkImageRegion(o_ptr->image(), rect);
+}
+
+RkImage RkImageAtlas::image() const
+{
+        o_ptr->setImageShared();
+        return o_ptr->image();
+}
@@ -0,0 +1,99 @@
+/**
+ * File name: RkImageAtlasImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkImageAtlasImpl.h"
+
+// Space between the images, avoids bleeding when the atlas is drawn scaled.
+constexpr int rkAtlasPadding = 1;
+
+RkImageAtlas::RkImageAtlasImpl::RkImageAtlasImpl(RkImageAtlas *interface, const RkImage &image)
+        : inf_ptr{interface}
+        , atlasImage{image}
+        , shelvesHeight{0}
+        , imageShared{false}
+{
+        RK_UNUSED(inf_ptr);
+}
+
+RkImageAtlas::RkImageAtlasImpl::~RkImageAtlasImpl()
+{
+}
+
+bool RkImageAtlas::RkImageAtlasImpl::allocate(const RkSize &size, RkRect &rect)
+{
+        auto width = size.width() + rkAtlasPadding;
+        auto height = size.height() + rkAtlasPadding;
+        if (size.width() < 1 || size.height() < 1
+            || size.width() > atlasImage.width() || size.height() > atlasImage.height())
+                return false;
+
+        // Best fit: the shelf with the least height wasted.
+        Shelf *bestShelf = nullptr;
+        for (auto &shelf: atlasShelves) {
+                if (shelf.height >= height && atlasImage.width() - shelf.width >= width
+                    && (!bestShelf || shelf.height < bestShelf->height))
+                        bestShelf = &shelf;
+        }
+
+        if (!bestShelf) {
+                if (atlasImage.height() - shelvesHeight < size.height())
+                        return false;
+                atlasShelves.push_back({shelvesHeight, height, 0});
+                shelvesHeight += height;
+                bestShelf = &atlasShelves.back();
+        }
+
+        rect = RkRect(bestShelf->width, bestShelf->y, size.width(), size.height());
+        bestShelf->width += width;
+        return true;
+}
+
+void RkImageAtlas::RkImageAtlasImpl::setRegion(const std::string &name, const RkRect &rect)
+{
+        namedRegions[name] = rect;
+}
+
+RkRect RkImageAtlas::RkImageAtlasImpl::region(const std::string &name) const
+{
+        auto res = namedRegions.find(name);
+        if (res != namedRegions.end())
+                return res->second;
+        return RkRect();
+}
+
+RkImage& RkImageAtlas::RkImageAtlasImpl::image()
+{
+        return atlasImage;
+}
+
+void RkImageAtlas::RkImageAtlasImpl::setImageShared()
+{
+        imageShared = true;
+}
+
+bool RkImageAtlas::RkImageAtlasImpl::takeImageShared()
+{
+        auto shared = imageShared;
+        imageShared = false;
+        return shared;
+}
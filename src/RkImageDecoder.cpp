@@ -0,0 +1,280 @@
+/**
+ * File name: RkImageDecoder.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkImageDecoder.h"
+#include "RkLog.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+constexpr int rkEncodingRaw = 0;
+constexpr int rkEncodingCompressed = 1;
+
+constexpr unsigned char rkQoiOpIndex = 0x00;
+constexpr unsigned char rkQoiOpDiff  = 0x40;
+constexpr unsigned char rkQoiOpLuma  = 0x80;
+constexpr unsigned char rkQoiOpRgb   = 0xfe;
+constexpr unsigned char rkQoiOpRgba  = 0xff;
+constexpr unsigned char rkQoiMask    = 0xc0;
+
+uint32_t readUint32(const unsigned char *data)
+{
+        return static_cast<uint32_t>(data[0])
+                | (static_cast<uint32_t>(data[1]) << 8)
+                | (static_cast<uint32_t>(data[2]) << 16)
+                | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+uint16_t readUint16(const unsigned char *data)
+{
+        return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t qoiPixel(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+        return (static_cast<uint32_t>(a) << 24)
+                | (static_cast<uint32_t>(r) << 16)
+                | (static_cast<uint32_t>(g) << 8)
+                | b;
+}
+
+bool decodeQoi(const unsigned char *in,
+               size_t n,
+               const RkSize &size,
+               unsigned char *pixels,
+               int stride)
+{
+        uint32_t index[64] = {0};
+        unsigned char r = 0, g = 0, b = 0, a = 255;
+        size_t pos = 0;
+        int run = 0;
+        for (int y = 0; y < size.height(); y++) {
+                auto row = reinterpret_cast<uint32_t*>(pixels + y * stride);
+                for (int x = 0; x < size.width(); x++) {
+                        if (run > 0) {
+                                run--;
+                        } else if (pos < n) {
+                                auto op = in[pos++];
+                                if (op == rkQoiOpRgb) {
+                                        if (pos + 3 > n)
+                                                return false;
+                                        r = in[pos++];
+                                        g = in[pos++];
+                                        b = in[pos++];
+                                } else if (op == rkQoiOpRgba) {
+                                        if (pos + 4 > n)
+                                                return false;
+                                        r = in[pos++];
+                                        g = in[pos++];
+                                        b = in[pos++];
+                                        a = in[pos++];
+                                } else if ((op & rkQoiMask) == rkQoiOpIndex) {
+                                        auto p = index[op];
+                                        a = p >> 24;
+                                        r = (p >> 16) & 0xff;
+                                        g = (p >> 8) & 0xff;
+                                        b = p & 0xff;
+                                } else if ((op & rkQoiMask) == rkQoiOpDiff) {
+                                        r += ((op >> 4) & 0x03) - 2;
+                                        g += ((op >> 2) & 0x03) - 2;
+                                        b += (op & 0x03) - 2;
+                                } else if ((op & rkQoiMask) == rkQoiOpLuma) {
+                                        if (pos >= n)
+                                                return false;
+                                        auto next = in[pos++];
+                                        int vg = (op & 0x3f) - 32;
+                                        r += vg - 8 + ((next >> 4) & 0x0f);
+                                        g += vg;
+                                        b += vg - 8 + (next & 0x0f);
+                                } else { // 0xc0, run of the previous pixel
+                                        run = op & 0x3f;
+                                }
+                                index[(r * 3 + g * 5 + b * 7 + a * 11) % 64] = qoiPixel(r, g, b, a);
+                        } else {
+                                return false;
+                        }
+                        row[x] = qoiPixel(r, g, b, a);
+                }
+        }
+        return true;
+}
+
+bool decodeRle(const unsigned char *in,
+               size_t n,
+               const RkSize &size,
+               unsigned char *pixels,
+               int stride)
+{
+        size_t pos = 0;
+        int count = 0;
+        bool repeat = false;
+        unsigned char value = 0;
+        for (int y = 0; y < size.height(); y++) {
+                auto row = pixels + y * stride;
+                for (int x = 0; x < size.width(); x++) {
+                        if (count == 0) {
+                                if (pos >= n)
+                                        return false;
+                                auto control = in[pos++];
+                                repeat = control >= 128;
+                                count = repeat ? control - 126 : control + 1;
+                                if (repeat) {
+                                        if (pos >= n)
+                                                return false;
+                                        value = in[pos++];
+                                }
+                        }
+                        if (!repeat) {
+                                if (pos >= n)
+                                        return false;
+                                value = in[pos++];
+                        }
+                        row[x] = value;
+                        count--;
+                }
+        }
+        return true;
+}
+
+} // namespace
+
+bool RkImageDecoder::isImage(const unsigned char *data)
+{
+        return data != nullptr && std::memcmp(data, "RKI1", 4) == 0;
+}
+
+bool RkImageDecoder::imageInfo(const unsigned char *data, RkSize &size, RkImage::Format &format)
+{
+        if (!isImage(data) || data[4] > static_cast<unsigned char>(RkImage::Format::A8))
+                return false;
+        format = static_cast<RkImage::Format>(data[4]);
+        size = RkSize(readUint32(data + 8), readUint32(data + 12));
+        return size.width() > 0 && size.height() > 0;
+}
+
+size_t RkImageDecoder::imageSize(const unsigned char *data)
+{
+        if (!isImage(data))
+                return 0;
+        return headerSize + readUint32(data + 16);
+}
+
+bool RkImageDecoder::decode(const unsigned char *data, unsigned char *pixels, int stride)
+{
+        RkSize size;
+        RkImage::Format format;
+        if (!imageInfo(data, size, format))
+                return false;
+
+        auto payload = data + headerSize;
+        auto n = readUint32(data + 16);
+        auto pixelLength = format == RkImage::Format::A8 ? 1 : 4;
+        switch (data[5])
+        {
+        case rkEncodingRaw:
+                if (n < static_cast<size_t>(size.width() * size.height() * pixelLength))
+                        return false;
+                for (int y = 0; y < size.height(); y++)
+                        std::memcpy(pixels + y * stride, payload + y * size.width() * pixelLength, size.width() * pixelLength);
+                return true;
+        case rkEncodingCompressed:
+                if (format == RkImage::Format::A8)
+                        return decodeRle(payload, n, size, pixels, stride);
+                return decodeQoi(payload, n, size, pixels, stride);
+        default:
+                RK_LOG_ERROR("unknown image encoding: " << static_cast<int>(data[5]));
+                return false;
+        }
+}
+
+bool RkImageDecoder::isBlob(const unsigned char *data, size_t size)
+{
+        return data != nullptr && size >= blobHeaderSize && std::memcmp(data, "RKB1", 4) == 0;
+}
+
+namespace {
+
+/**
+ * Calls found(name, image) for every entry of the blob index, stops at the
+ * end of the blob. The images outside the blob or truncated are skipped.
+ */
+template<class Found>
+void forEachBlobImage(const unsigned char *blob, size_t size, Found found)
+{
+        if (!RkImageDecoder::isBlob(blob, size))
+                return;
+
+        auto count = readUint32(blob + 4);
+        size_t pos = RkImageDecoder::blobHeaderSize;
+        for (decltype(count) i = 0; i < count; i++) {
+                if (size - pos < 2)
+                        return;
+                size_t length = readUint16(blob + pos);
+                if (size - pos - 2 < length + 4)
+                        return;
+                std::string_view name(reinterpret_cast<const char*>(blob + pos + 2), length);
+                size_t offset = readUint32(blob + pos + 2 + length);
+                pos += 2 + length + 4;
+                if (offset >= size || size - offset < RkImageDecoder::headerSize)
+                        continue;
+                auto image = blob + offset;
+                auto imageSize = RkImageDecoder::imageSize(image);
+                if (imageSize != 0 && imageSize <= size - offset && !found(name, image))
+                        return;
+        }
+}
+
+} // namespace
+
+const unsigned char* RkImageDecoder::findImage(const unsigned char *blob, size_t size, const std::string &name)
+{
+        const unsigned char *image = nullptr;
+        forEachBlobImage(blob, size, [&](std::string_view entryName, const unsigned char *entryImage) {
+                        if (entryName != name)
+                                return true;
+                        image = entryImage;
+                        return false;
+                });
+        return image;
+}
+
+std::vector<std::pair<double, const unsigned char*>>
+RkImageDecoder::findVariants(const unsigned char *blob, size_t size, const std::string &name)
+{
+        std::vector<std::pair<double, const unsigned char*>> variants;
+        auto prefix = name + "@";
+        forEachBlobImage(blob, size, [&](std::string_view entryName, const unsigned char *entryImage) {
+                        if (entryName.size() > prefix.size() + 1
+                            && entryName.compare(0, prefix.size(), prefix) == 0
+                            && entryName.back() == 'x') {
+                                auto scale = std::strtod(std::string(entryName.substr(prefix.size())).c_str(), nullptr);
+                                if (scale > 0)
+                                        variants.emplace_back(scale, entryImage);
+                        }
+                        return true;
+                });
+        return variants;
+}
@@ -0,0 +1,281 @@
+/**
+ * File name: RkImageDiskCache.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkImageDiskCache.h"
+#include "RkLog.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t rkDiskCacheVersion = 1;
+constexpr size_t rkDiskCacheAlignment = 64;
+// Entries not used in the last syncs are dropped.
+constexpr uint32_t rkDiskCacheMaxAge = 4;
+
+uint64_t tableHash(const unsigned char *data, size_t n)
+{
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < n; i++) {
+                hash ^= data[i];
+                hash *= 1099511628211ULL;
+        }
+        return hash;
+}
+
+size_t alignOffset(size_t offset)
+{
+        return (offset + rkDiskCacheAlignment - 1) & ~(rkDiskCacheAlignment - 1);
+}
+
+} // namespace
+
+RkImageDiskCache::RkImageDiskCache()
+        : cacheOpen{false}
+        , mappedData{nullptr}
+        , mappedSize{0}
+        , mappedEntries{nullptr}
+        , generation{0}
+{
+}
+
+RkImageDiskCache::~RkImageDiskCache()
+{
+        if (mappedData)
+                munmap(mappedData, mappedSize);
+        for (const auto &mapping: oldMappings)
+                munmap(mapping.first, mapping.second);
+}
+
+bool RkImageDiskCache::open(const std::string &file)
+{
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        cacheFile = file;
+        cacheOpen = true;
+        return map(file);
+}
+
+bool RkImageDiskCache::isOpen() const
+{
+        return cacheOpen;
+}
+
+bool RkImageDiskCache::map(const std::string &file)
+{
+        // The images can still reference the current mapping.
+        if (mappedData)
+                oldMappings.emplace_back(mappedData, mappedSize);
+        mappedData = nullptr;
+        mappedSize = 0;
+        mappedEntries = nullptr;
+        generation = 0;
+        index.clear();
+
+        auto fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0)
+                return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+                ::close(fd);
+                return false;
+        }
+
+        auto size = static_cast<size_t>(info.st_size);
+        auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+                RK_LOG_ERROR("can't map image cache file: " << file);
+                return false;
+        }
+
+        if (!isValid(static_cast<unsigned char*>(data), size)) {
+                RK_LOG_ERROR("invalid image cache file: " << file);
+                munmap(data, size);
+                return false;
+        }
+
+        mappedData = static_cast<unsigned char*>(data);
+        mappedSize = size;
+        auto header = reinterpret_cast<const Header*>(mappedData);
+        generation = header->generation;
+        mappedEntries = reinterpret_cast<const Entry*>(mappedData + sizeof(Header));
+        for (uint32_t i = 0; i < header->count; i++) {
+                const auto &entry = mappedEntries[i];
+                index.emplace(Key(entry.hash, entry.scale), std::make_pair(&entry, false));
+        }
+        return true;
+}
+
+bool RkImageDiskCache::isValid(const unsigned char *data, size_t size) const
+{
+        auto header = reinterpret_cast<const Header*>(data);
+        if (std::memcmp(header->magic, "RKIC", 4) != 0 || header->version != rkDiskCacheVersion)
+                return false;
+
+        auto tableSize = static_cast<size_t>(header->count) * sizeof(Entry);
+        if (sizeof(Header) + tableSize > size)
+                return false;
+
+        auto table = data + sizeof(Header);
+        if (tableHash(table, tableSize) != header->tableHash)
+                return false;
+
+        auto entries = reinterpret_cast<const Entry*>(table);
+        for (uint32_t i = 0; i < header->count; i++) {
+                const auto &entry = entries[i];
+                if (entry.format > static_cast<uint32_t>(RkImage::Format::A8)
+                    || entry.width == 0
+                    || entry.height == 0
+                    || entry.width > static_cast<uint32_t>(std::numeric_limits<int>::max())
+                    || entry.height > static_cast<uint32_t>(std::numeric_limits<int>::max())
+                    || entry.stride > static_cast<uint32_t>(std::numeric_limits<int>::max())
+                    || entry.offset % rkDiskCacheAlignment != 0)
+                        return false;
+
+                // In 64 bits, the stride and the height are below 2^31.
+                uint64_t pixelLength = entry.format == static_cast<uint32_t>(RkImage::Format::A8) ? 1 : 4;
+                uint64_t pixelsSize = static_cast<uint64_t>(entry.stride) * entry.height;
+                // Cairo rows are aligned to 4 bytes.
+                if (entry.stride < entry.width * pixelLength
+                    || entry.stride % 4 != 0
+                    || entry.offset > size
+                    || pixelsSize > size - entry.offset)
+                        return false;
+        }
+        return true;
+}
+
+RkImageDiskCache::Pixels RkImageDiskCache::find(uint64_t hash, double scale)
+{
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        Pixels pixels;
+        auto res = index.find(Key(hash, scale));
+        if (res == index.end())
+                return pixels;
+
+        auto entry = res->second.first;
+        res->second.second = true;
+        pixels.data = mappedData + entry->offset;
+        pixels.size = RkSize(entry->width, entry->height);
+        pixels.format = static_cast<RkImage::Format>(entry->format);
+        pixels.stride = entry->stride;
+        return pixels;
+}
+
+void RkImageDiskCache::insert(uint64_t hash, double scale, const RkImage &image)
+{
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (cacheOpen && !image.isNull())
+                newEntries.emplace(Key(hash, scale), image);
+}
+
+bool RkImageDiskCache::sync()
+{
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (!cacheOpen)
+                return false;
+
+        bool changed = !newEntries.empty();
+        std::vector<Entry> entries;
+        std::vector<const unsigned char*> sources;
+        auto nextGeneration = generation + 1;
+        for (const auto &item: index) {
+                auto entry = *item.second.first;
+                if (item.second.second) {
+                        entry.generation = nextGeneration;
+                } else if (nextGeneration - entry.generation > rkDiskCacheMaxAge) {
+                        changed = true;
+                        continue;
+                }
+                entries.push_back(entry);
+                sources.push_back(mappedData + item.second.first->offset);
+        }
+
+        for (const auto &item: newEntries) {
+                if (index.find(item.first) != index.end())
+                        continue;
+                const auto &image = item.second;
+                Entry entry;
+                std::memset(&entry, 0, sizeof(entry));
+                entry.hash = item.first.first;
+                entry.scale = item.first.second;
+                entry.format = static_cast<uint32_t>(image.format());
+                entry.width = image.width();
+                entry.height = image.height();
+                entry.stride = image.stride();
+                entry.generation = nextGeneration;
+                entries.push_back(entry);
+                sources.push_back(image.data());
+        }
+
+        // Only the generations changed, not worth a rewrite.
+        if (!changed)
+                return true;
+
+        size_t offset = alignOffset(sizeof(Header) + entries.size() * sizeof(Entry));
+        for (auto &entry: entries) {
+                entry.offset = offset;
+                offset = alignOffset(offset + static_cast<size_t>(entry.stride) * entry.height);
+        }
+
+        Header header;
+        std::memcpy(header.magic, "RKIC", 4);
+        header.version = rkDiskCacheVersion;
+        header.count = entries.size();
+        header.generation = nextGeneration;
+        header.tableHash = tableHash(reinterpret_cast<const unsigned char*>(entries.data()),
+                                     entries.size() * sizeof(Entry));
+
+        // Written to a temporary file and renamed, a crash never leaves a half written cache.
+        auto tmpFile = cacheFile + ".tmp";
+        auto fptr = std::fopen(tmpFile.c_str(), "wb");
+        if (fptr == nullptr) {
+                RK_LOG_ERROR("can't write image cache file: " << tmpFile);
+                return false;
+        }
+
+        bool ok = std::fwrite(&header, sizeof(header), 1, fptr) == 1;
+        if (!entries.empty())
+                ok = ok && std::fwrite(entries.data(), sizeof(Entry), entries.size(), fptr) == entries.size();
+        for (size_t i = 0; i < entries.size() && ok; i++) {
+                ok = std::fseek(fptr, entries[i].offset, SEEK_SET) == 0
+                        && std::fwrite(sources[i], entries[i].stride, entries[i].height, fptr) == entries[i].height;
+        }
+        ok = std::fclose(fptr) == 0 && ok;
+        if (!ok || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+                RK_LOG_ERROR("can't write image cache file: " << cacheFile);
+                std::remove(tmpFile.c_str());
+                return false;
+        }
+
+        newEntries.clear();
+        return map(cacheFile);
+}
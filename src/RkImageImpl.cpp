@@ -22,12 +22,18 @@
  */
 
 #include "RkImageImpl.h"
+#include "RkImageDecoder.h"
+#include "RkPixelOps.h"
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
 #include "RkCairoImageBackendCanvas.h"
 #else
 #error No graphics backend defined.
 #endif
 
+#include <cmath>
+#include <cstring>
+#include <utility>
+
 RkImage::RkImageImpl::RkImageImpl(RkImage *interface,
                                   int width,
                                   int height,
@@ -36,12 +42,35 @@ RkImage::RkImageImpl::RkImageImpl(RkImage *interface,
         : inf_ptr{interface}
         , imageFormat{format}
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
-        , imageBackendCanvas{std::make_unique<RkCairoImageBackendCanvas>(RkSize(width, height), imageFormat, data)}
+        , imageBackendCanvas{std::make_shared<RkCairoImageBackendCanvas>(RkSize(width, height), imageFormat, data)}
 #else
 #error No graphics backend defined
 #endif
 {
-        RK_UNUSED(inf_ptr);
+}
+
+RkImage::RkImageImpl::RkImageImpl(RkImage *interface, const RkImageImpl &other)
+        : inf_ptr{interface}
+        , imageFormat{other.imageFormat}
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+        , imageBackendCanvas{other.imageBackendCanvas}
+#else
+#error No graphics backend defined
+#endif
+        , imageVariants{other.imageVariants}
+{
+}
+
+RkImage::RkImageImpl::RkImageImpl(RkImage *interface, RkImageImpl &&other)
+        : inf_ptr{interface}
+        , imageFormat{other.imageFormat}
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+        , imageBackendCanvas{std::move(other.imageBackendCanvas)}
+#else
+#error No graphics backend defined
+#endif
+        , imageVariants{std::move(other.imageVariants)}
+{
 }
 
 RkImage::RkImageImpl::~RkImageImpl()
@@ -55,9 +84,19 @@ const RkCanvasInfo* RkImage::RkImageImpl::getCanvasInfo() const
         return nullptr;
 }
 
-unsigned char* RkImage::RkImageImpl::data() const
+unsigned char* RkImage::RkImageImpl::data()
+{
+        detach();
+        if (imageBackendCanvas)
+                return imageBackendCanvas->data();
+        return nullptr;
+}
+
+const unsigned char* RkImage::RkImageImpl::constData() const
 {
-        return imageBackendCanvas->data();
+        if (imageBackendCanvas)
+                return imageBackendCanvas->data();
+        return nullptr;
 }
 
 std::vector<unsigned char> RkImage::RkImageImpl::dataCopy() const
@@ -86,6 +125,13 @@ int RkImage::RkImageImpl::height() const
         return 0;
 }
 
+int RkImage::RkImageImpl::stride() const
+{
+        if (imageBackendCanvas)
+                return imageBackendCanvas->stride();
+        return 0;
+}
+
 RkSize RkImage::RkImageImpl::size() const
 {
         if (imageBackendCanvas)
@@ -98,22 +144,216 @@ bool RkImage::RkImageImpl::isNull() const
         return !imageBackendCanvas || imageBackendCanvas->isNull();
 }
 
-void RkImage::RkImageImpl::createImage(const RkSize &size,
-                                       RkImage::Format format,
-                                       const unsigned char *data)
+bool RkImage::RkImageImpl::isDecoded() const
+{
+        return !imageBackendCanvas || imageBackendCanvas->isDecoded();
+}
+
+void RkImage::RkImageImpl::share(const RkImageImpl &other)
+{
+        imageFormat = other.imageFormat;
+        imageBackendCanvas = other.imageBackendCanvas;
+        imageVariants = other.imageVariants;
+}
+
+void RkImage::RkImageImpl::take(RkImageImpl &other)
+{
+        imageFormat = other.imageFormat;
+        imageBackendCanvas = std::move(other.imageBackendCanvas);
+        imageVariants = std::move(other.imageVariants);
+}
+
+void RkImage::RkImageImpl::detach()
+{
+        if (imageBackendCanvas && (imageBackendCanvas.use_count() > 1 || imageBackendCanvas->isBorrowed())) {
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+                imageBackendCanvas = std::make_shared<RkCairoImageBackendCanvas>(std::as_const(*imageBackendCanvas));
+#else
+#error No graphics backend defined
+#endif
+                // The other copies keep the variants generated from the old pixels.
+                std::shared_ptr<RkImageVariants> variants;
+                if (imageVariants) {
+                        std::lock_guard<std::mutex> lock(imageVariants->variantsMutex);
+                        for (const auto &variant: imageVariants->variants) {
+                                if (variant.second.generated)
+                                        continue;
+                                if (!variants)
+                                        variants = std::make_shared<RkImageVariants>();
+                                variants->variants.insert(variant);
+                        }
+                }
+                imageVariants = variants;
+        } else {
+                dropGeneratedVariants();
+        }
+}
+
+void RkImage::RkImageImpl::dropGeneratedVariants()
+{
+        if (!imageVariants)
+                return;
+        std::lock_guard<std::mutex> lock(imageVariants->variantsMutex);
+        auto &variants = imageVariants->variants;
+        for (auto it = variants.begin(); it != variants.end();) {
+                if (it->second.generated)
+                        it = variants.erase(it);
+                else
+                        ++it;
+        }
+}
+
+void RkImage::RkImageImpl::borrow(const RkSize &size,
+                                  RkImage::Format format,
+                                  const unsigned char *data,
+                                  int stride)
 {
         imageFormat = format;
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
-        if (imageBackendCanvas)
-                imageBackendCanvas = std::make_unique<RkCairoImageBackendCanvas>(size, format, data);
+        imageBackendCanvas = std::make_shared<RkCairoImageBackendCanvas>(size, format, data, true, stride);
 #else
 #error No graphics backend defined
 #endif
 }
 
+bool RkImage::RkImageImpl::load(const std::string &file)
+{
+        imageFormat = RkImage::Format::ARGB32;
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+        imageBackendCanvas = std::make_shared<RkCairoImageBackendCanvas>(file);
+#else
+#error No graphics backend defined
+#endif
+        return !imageBackendCanvas->isNull();
+}
+
+bool RkImage::RkImageImpl::loadResource(const unsigned char *resource)
+{
+        RkSize size;
+        if (!RkImageDecoder::imageInfo(resource, size, imageFormat))
+                return false;
+#ifdef RK_GRAPHICS_CAIRO_BACKEND
+        imageBackendCanvas = std::make_shared<RkCairoImageBackendCanvas>(resource);
+#else
+#error No graphics backend defined
+#endif
+        return true;
+}
+
+long RkImage::RkImageImpl::useCount() const
+{
+        return imageBackendCanvas.use_count();
+}
+
+bool RkImage::RkImageImpl::isEqual(const RkImageImpl &other) const
+{
+        if (imageBackendCanvas == other.imageBackendCanvas)
+                return true;
+        if (isNull() || other.isNull())
+                return isNull() && other.isNull();
+        if (imageFormat != other.imageFormat || size() != other.size())
+                return false;
+        const auto &canvas = std::as_const(*imageBackendCanvas);
+        const auto &otherCanvas = std::as_const(*other.imageBackendCanvas);
+        auto n = static_cast<size_t>(stride()) * static_cast<size_t>(height());
+        return std::memcmp(canvas.data(), otherCanvas.data(), n) == 0;
+}
+
 void RkImage::RkImageImpl::fill(const RkColor &color)
 {
+        detach();
         if (imageBackendCanvas)
                 imageBackendCanvas->fill(color);
 }
 
+void RkImage::RkImageImpl::fill(const RkColor &color, const RkRect &rect)
+{
+        detach();
+        if (imageBackendCanvas)
+                imageBackendCanvas->fill(color, rect);
+}
+
+void RkImage::RkImageImpl::scroll(int dx, int dy)
+{
+        detach();
+        if (imageBackendCanvas)
+                imageBackendCanvas->scroll(dx, dy);
+}
+
+void RkImage::RkImageImpl::applyAlpha(int alpha)
+{
+        detach();
+        if (imageBackendCanvas)
+                imageBackendCanvas->applyAlpha(alpha);
+}
+
+void RkImage::RkImageImpl::paste(const RkImageImpl &image, int x, int y)
+{
+        if (imageBackendCanvas && image.imageBackendCanvas) {
+                imageBackendCanvas->paste(*image.imageBackendCanvas, x, y);
+                dropGeneratedVariants();
+        }
+}
+
+void RkImage::RkImageImpl::setVariant(double scale, const RkImage &image)
+{
+        if (isNull() || image.isNull() || image.format() != imageFormat || scale <= 0)
+                return;
+
+        if (!imageVariants || imageVariants.use_count() > 1) {
+                auto variants = std::make_shared<RkImageVariants>();
+                if (imageVariants) {
+                        std::lock_guard<std::mutex> lock(imageVariants->variantsMutex);
+                        variants->variants = imageVariants->variants;
+                }
+                imageVariants = variants;
+        }
+
+        // The generated variants may now have a better source.
+        dropGeneratedVariants();
+        std::lock_guard<std::mutex> lock(imageVariants->variantsMutex);
+        imageVariants->variants[scale] = {image, false};
+}
+
+bool RkImage::RkImageImpl::hasVariants() const
+{
+        return imageVariants != nullptr;
+}
+
+RkImage RkImage::RkImageImpl::variant(double scale) const
+{
+        if (isNull() || !imageVariants || scale <= 0)
+                return *inf_ptr;
+
+        std::lock_guard<std::mutex> lock(imageVariants->variantsMutex);
+        auto &variants = imageVariants->variants;
+        auto res = variants.find(scale);
+        if (res != variants.end())
+                return res->second.image;
+        if (std::abs(scale - 1.0) < 1e-6)
+                return *inf_ptr;
+
+        // The closest variant with enough pixels is downsampled, if there is none
+        // the largest one is upsampled.
+        const RkImage *source = inf_ptr;
+        double sourceScale = 1.0;
+        for (const auto &v: variants) {
+                if (v.second.generated)
+                        continue;
+                if ((v.first >= scale && (sourceScale < scale || v.first < sourceScale))
+                    || (sourceScale < scale && v.first > sourceScale)) {
+                        source = &v.second.image;
+                        sourceScale = v.first;
+                }
+        }
+
+        RkSize size(std::max(static_cast<int>(std::lround(width() * scale)), 1),
+                    std::max(static_cast<int>(std::lround(height() * scale)), 1));
+        RkImage image(size, nullptr, imageFormat);
+        const RkImage &src = *source;
+        RkPixelOps::resample(src.data(), src.stride(), src.width(), src.height(),
+                             image.data(), image.stride(), size.width(), size.height(),
+                             imageFormat == RkImage::Format::A8 ? 1 : 4);
+        variants[scale] = {image, true};
+        return image;
+}
@@ -0,0 +1,270 @@
+/**
+ * File name: RkImageLoader.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkImageLoader.h"
+#include "RkImageRegistry.h"
+#include "RkEventQueue.h"
+#include "RkAction.h"
+#include "RkLog.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+struct RkImageLoadRequest {
+        std::mutex requestMutex;
+        bool cancelled = false;
+        RkEventQueue *queue = nullptr;
+        RkImageLoader *loader = nullptr;
+        std::string file;
+        const unsigned char *resource = nullptr;
+        // Key in the pool queue: higher priority first, then FIFO.
+        std::pair<int, uint64_t> order;
+};
+
+class RkImageLoaderPool {
+ public:
+        using Request = std::shared_ptr<RkImageLoadRequest>;
+
+        static RkImageLoaderPool& instance()
+        {
+                static RkImageLoaderPool pool;
+                return pool;
+        }
+
+        ~RkImageLoaderPool()
+        {
+                {
+                        std::lock_guard<std::mutex> lock(poolMutex);
+                        stopWorkers = true;
+                        pendingRequests.clear();
+                }
+                poolCondition.notify_all();
+                for (auto &worker: workers)
+                        worker.join();
+        }
+
+        void setThreads(int n)
+        {
+                std::lock_guard<std::mutex> lock(poolMutex);
+                if (!workers.empty())
+                        RK_LOG_ERROR("the image loader threads are already started");
+                else
+                        threadsNumber = std::max(n, 1);
+        }
+
+        void submit(const Request &request, int priority)
+        {
+                {
+                        std::lock_guard<std::mutex> lock(poolMutex);
+                        if (workers.empty()) {
+                                for (int i = 0; i < threadsNumber; i++)
+                                        workers.emplace_back(&RkImageLoaderPool::run, this);
+                        }
+                        request->order = {-priority, nextSequence++};
+                        pendingRequests.emplace(request->order, request);
+                }
+                poolCondition.notify_one();
+        }
+
+        void setPriority(const Request &request, int priority)
+        {
+                std::lock_guard<std::mutex> lock(poolMutex);
+                auto res = pendingRequests.find(request->order);
+                if (res == pendingRequests.end())
+                        return;
+                pendingRequests.erase(res);
+                request->order.first = -priority;
+                pendingRequests.emplace(request->order, request);
+        }
+
+        void remove(const Request &request)
+        {
+                std::lock_guard<std::mutex> lock(poolMutex);
+                pendingRequests.erase(request->order);
+        }
+
+ private:
+        RkImageLoaderPool()
+                : stopWorkers{false}
+                , nextSequence{0}
+        {
+                // The registry must outlive the workers that load through it.
+                RkImageRegistry::statistics();
+                auto n = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+                threadsNumber = std::clamp(n, 1, 4);
+        }
+
+        void run()
+        {
+                for (;;) {
+                        Request request;
+                        {
+                                std::unique_lock<std::mutex> lock(poolMutex);
+                                poolCondition.wait(lock, [this] {
+                                                return stopWorkers || !pendingRequests.empty();
+                                        });
+                                if (stopWorkers)
+                                        return;
+                                request = pendingRequests.begin()->second;
+                                pendingRequests.erase(pendingRequests.begin());
+                        }
+                        load(request);
+                }
+        }
+
+        void load(const Request &request)
+        {
+                {
+                        std::lock_guard<std::mutex> lock(request->requestMutex);
+                        if (request->cancelled)
+                                return;
+                }
+
+                RkImage image;
+                if (request->resource)
+                        image = RkImageRegistry::image(request->resource);
+                else
+                        image = RkImageRegistry::image(request->file);
+                // Lazy resources are decoded here, not on the first paint.
+                static_cast<const RkImage&>(image).data();
+
+                // The loader cancels under the same lock before it is deleted.
+                std::lock_guard<std::mutex> lock(request->requestMutex);
+                if (request->cancelled)
+                        return;
+                auto loader = request->loader;
+                auto act = std::make_unique<RkAction>(loader);
+                act->setCallback([loader, request, image](void) {
+                                loader->finish(request, image);
+                        });
+                request->queue->postAction(std::move(act));
+        }
+
+        std::mutex poolMutex;
+        std::condition_variable poolCondition;
+        std::map<std::pair<int, uint64_t>, Request> pendingRequests;
+        std::vector<std::thread> workers;
+        bool stopWorkers;
+        uint64_t nextSequence;
+        int threadsNumber;
+};
+
+RkImageLoader::RkImageLoader(RkObject *parent)
+        : RkObject(parent)
+        , loadRequest{nullptr}
+        , loadPriority{Priority::Normal}
+{
+}
+
+RkImageLoader::~RkImageLoader()
+{
+        cancel();
+}
+
+void RkImageLoader::load(const std::string &file, Priority priority)
+{
+        auto request = std::make_shared<RkImageLoadRequest>();
+        request->file = file;
+        loadPriority = priority;
+        submit(std::move(request));
+}
+
+void RkImageLoader::load(const unsigned char *resource, Priority priority)
+{
+        auto request = std::make_shared<RkImageLoadRequest>();
+        request->resource = resource;
+        loadPriority = priority;
+        submit(std::move(request));
+}
+
+void RkImageLoader::submit(std::shared_ptr<RkImageLoadRequest> request)
+{
+        cancel();
+        if (!eventQueue()) {
+                RK_LOG_DEBUG("no event queue, load on the calling thread");
+                auto image = request->resource ? RkImageRegistry::image(request->resource)
+                                               : RkImageRegistry::image(request->file);
+                loadRequest = request;
+                finish(request, image);
+                return;
+        }
+
+        request->queue = eventQueue();
+        request->loader = this;
+        loadRequest = request;
+        RkImageLoaderPool::instance().submit(request, static_cast<int>(loadPriority));
+}
+
+void RkImageLoader::finish(const std::shared_ptr<RkImageLoadRequest> &request, const RkImage &image)
+{
+        // A newer load() or cancel() replaced the request.
+        if (request != loadRequest)
+                return;
+        loadRequest = nullptr;
+        loadedImage = image;
+        action imageLoaded(loadedImage);
+}
+
+void RkImageLoader::setPriority(Priority priority)
+{
+        loadPriority = priority;
+        if (loadRequest && loadRequest->queue)
+                RkImageLoaderPool::instance().setPriority(loadRequest, static_cast<int>(priority));
+}
+
+RkImageLoader::Priority RkImageLoader::priority() const
+{
+        return loadPriority;
+}
+
+void RkImageLoader::cancel()
+{
+        if (!loadRequest)
+                return;
+
+        {
+                std::lock_guard<std::mutex> lock(loadRequest->requestMutex);
+                loadRequest->cancelled = true;
+        }
+        if (loadRequest->queue)
+                RkImageLoaderPool::instance().remove(loadRequest);
+        loadRequest = nullptr;
+}
+
+bool RkImageLoader::isLoading() const
+{
+        return loadRequest != nullptr;
+}
+
+const RkImage& RkImageLoader::image() const
+{
+        return loadedImage;
+}
+
+void RkImageLoader::setThreads(int n)
+{
+        RkImageLoaderPool::instance().setThreads(n);
+}
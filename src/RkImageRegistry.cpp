@@ -0,0 +1,465 @@
+/**
+ * File name: RkImageRegistry.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkImageRegistry.h"
+#include "RkImageImpl.h"
+#include "RkImageDecoder.h"
+#include "RkImageDiskCache.h"
+#include "RkLog.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+struct RkImageRegistryEntry {
+        RkImage image;
+        uint64_t hash;
+        // Compact rkpng2c resource, the hash is of the encoded bytes.
+        const unsigned char *resource = nullptr;
+        size_t resourceSize = 0;
+};
+
+struct RkImageRegistryFileEntry {
+        std::string file;
+        time_t modificationTime;
+        RkImage image;
+};
+
+struct RkImageRegistryData {
+        using Key = std::tuple<const unsigned char*, int, int, int>;
+        std::mutex registryMutex;
+        // Destroyed after the images that reference its pages.
+        RkImageDiskCache diskCache;
+        std::map<Key, std::shared_ptr<RkImageRegistryEntry>> pointerIndex;
+        std::unordered_multimap<uint64_t, std::shared_ptr<RkImageRegistryEntry>> contentIndex;
+        // Most recently used file images are at the front.
+        std::list<RkImageRegistryFileEntry> fileCache;
+        std::unordered_map<std::string, std::list<RkImageRegistryFileEntry>::iterator> fileIndex;
+        std::unordered_map<std::string, std::shared_future<RkImage>> pendingFiles;
+        size_t fileCacheBytes = 0;
+        size_t fileCacheLimit = 32 * 1024 * 1024;
+        size_t hits = 0;
+        size_t misses = 0;
+        // Destroyed first, waits for the running preloads.
+        std::vector<std::future<void>> preloadTasks;
+};
+
+RkImageRegistryData& registryData()
+{
+        static RkImageRegistryData data;
+        return data;
+}
+
+size_t imageBytes(const RkImage &image)
+{
+        return static_cast<size_t>(image.stride()) * static_cast<size_t>(image.height());
+}
+
+size_t rowLength(int width, RkImage::Format format)
+{
+        return static_cast<size_t>(width) * (format == RkImage::Format::A8 ? 1 : 4);
+}
+
+// Compares the image pixels with tightly packed rows.
+bool hasPixels(const RkImage &image, const unsigned char *data)
+{
+        auto length = rowLength(image.width(), image.format());
+        auto pixels = image.data();
+        for (int y = 0; y < image.height(); y++) {
+                if (std::memcmp(pixels + y * image.stride(), data + y * length, length) != 0)
+                        return false;
+        }
+        return true;
+}
+
+// FNV-1a
+uint64_t contentHash(const unsigned char *data, size_t n)
+{
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < n; i++) {
+                hash ^= data[i];
+                hash *= 1099511628211ULL;
+        }
+        return hash;
+}
+
+bool readFile(const std::string &file, std::vector<unsigned char> &data)
+{
+        std::ifstream stream(file, std::ios::binary | std::ios::ate);
+        if (!stream)
+                return false;
+        data.resize(stream.tellg());
+        stream.seekg(0);
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(data.data()), data.size()));
+}
+
+time_t modificationTime(const std::string &file)
+{
+        struct stat info;
+        if (stat(file.c_str(), &info) != 0)
+                return 0;
+        return info.st_mtime;
+}
+
+void removeFileEntry(RkImageRegistryData &registry,
+                     std::list<RkImageRegistryFileEntry>::iterator it)
+{
+        registry.fileCacheBytes -= imageBytes(it->image);
+        registry.fileIndex.erase(it->file);
+        registry.fileCache.erase(it);
+}
+
+void trimFileCache(RkImageRegistryData &registry)
+{
+        while (registry.fileCacheBytes > registry.fileCacheLimit && !registry.fileCache.empty())
+                removeFileEntry(registry, std::prev(registry.fileCache.end()));
+}
+
+void insertFileEntry(RkImageRegistryData &registry,
+                     const std::string &file,
+                     time_t mtime,
+                     const RkImage &image)
+{
+        auto res = registry.fileIndex.find(file);
+        if (res != registry.fileIndex.end())
+                removeFileEntry(registry, res->second);
+        if (image.isNull())
+                return;
+        registry.fileCache.push_front({file, mtime, image});
+        registry.fileIndex.emplace(file, registry.fileCache.begin());
+        registry.fileCacheBytes += imageBytes(image);
+        trimFileCache(registry);
+}
+
+// Returns the cached image if it is still up to date with the file.
+bool findFileEntry(RkImageRegistryData &registry,
+                   const std::string &file,
+                   time_t mtime,
+                   RkImage &image)
+{
+        auto res = registry.fileIndex.find(file);
+        if (res == registry.fileIndex.end())
+                return false;
+        if (res->second->modificationTime != mtime) {
+                removeFileEntry(registry, res->second);
+                return false;
+        }
+        registry.fileCache.splice(registry.fileCache.begin(), registry.fileCache, res->second);
+        image = res->second->image;
+        return true;
+}
+
+} // namespace
+
+double RkImageRegistry::Statistics::hitRate() const
+{
+        if (hits + misses == 0)
+                return 0.0;
+        return static_cast<double>(hits) / static_cast<double>(hits + misses);
+}
+
+RkImage RkImageRegistry::image(int width,
+                               int height,
+                               const unsigned char *data,
+                               RkImage::Format format)
+{
+        return image(RkSize(width, height), data, format);
+}
+
+RkImage RkImageRegistry::image(const RkSize &size,
+                               const unsigned char *data,
+                               RkImage::Format format)
+{
+        if (data == nullptr || size.width() < 1 || size.height() < 1)
+                return RkImage(size, data, format);
+
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        RkImageRegistryData::Key key{data, size.width(), size.height(), static_cast<int>(format)};
+        auto res = registry.pointerIndex.find(key);
+        if (res != registry.pointerIndex.end()) {
+                registry.hits++;
+                return res->second->image;
+        }
+
+        // The same content can come from another resource array.
+        auto n = rowLength(size.width(), format) * static_cast<size_t>(size.height());
+        auto hash = contentHash(data, n);
+        auto range = registry.contentIndex.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+                const auto &image = it->second->image;
+                if (it->second->resource == nullptr
+                    && image.size() == size && image.format() == format && hasPixels(image, data)) {
+                        registry.hits++;
+                        registry.pointerIndex.emplace(key, it->second);
+                        return image;
+                }
+        }
+
+        registry.misses++;
+        auto entry = std::make_shared<RkImageRegistryEntry>();
+        entry->image.o_ptr->borrow(size, format, data);
+        entry->hash = hash;
+        registry.pointerIndex.emplace(key, entry);
+        registry.contentIndex.emplace(hash, entry);
+        return entry->image;
+}
+
+RkImage RkImageRegistry::image(const unsigned char *resource)
+{
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        bool created;
+        return resourceImage(resource, created);
+}
+
+RkImage& RkImageRegistry::resourceImage(const unsigned char *resource, bool &created)
+{
+        static RkImage nullImage;
+        created = false;
+        RkSize size;
+        RkImage::Format format;
+        if (!RkImageDecoder::imageInfo(resource, size, format))
+                return nullImage;
+
+        auto &registry = registryData();
+        RkImageRegistryData::Key key{resource, size.width(), size.height(), static_cast<int>(format)};
+        auto res = registry.pointerIndex.find(key);
+        if (res != registry.pointerIndex.end()) {
+                registry.hits++;
+                return res->second->image;
+        }
+
+        auto n = RkImageDecoder::imageSize(resource);
+        auto hash = contentHash(resource, n);
+        auto range = registry.contentIndex.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+                const auto &entry = it->second;
+                if (entry->resourceSize == n && std::memcmp(entry->resource, resource, n) == 0) {
+                        registry.hits++;
+                        registry.pointerIndex.emplace(key, entry);
+                        return entry->image;
+                }
+        }
+
+        registry.misses++;
+        created = true;
+        auto entry = std::make_shared<RkImageRegistryEntry>();
+        auto cached = registry.diskCache.find(hash, 1.0);
+        if (cached.data != nullptr) {
+                entry->image.o_ptr->borrow(cached.size, cached.format, cached.data, cached.stride);
+        } else {
+                entry->image.o_ptr->loadResource(resource);
+                registry.diskCache.insert(hash, 1.0, entry->image);
+        }
+        entry->hash = hash;
+        entry->resource = resource;
+        entry->resourceSize = n;
+        registry.pointerIndex.emplace(key, entry);
+        registry.contentIndex.emplace(hash, entry);
+        return entry->image;
+}
+
+RkImage RkImageRegistry::image(const unsigned char *blob, size_t size, const std::string &name)
+{
+        auto resource = RkImageDecoder::findImage(blob, size, name);
+        if (resource == nullptr) {
+                RK_LOG_ERROR("no image " << name << " in the resource blob");
+                return RkImage();
+        }
+
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        bool created;
+        auto &image = resourceImage(resource, created);
+        // The variants are set on the cached image, so all its copies share them.
+        if (created) {
+                for (const auto &variant: RkImageDecoder::findVariants(blob, size, name)) {
+                        bool variantCreated;
+                        image.setVariant(variant.first, resourceImage(variant.second, variantCreated));
+                }
+        }
+        return image;
+}
+
+RkImage RkImageRegistry::loadImage(const std::string &file)
+{
+        RkImage image;
+        auto &diskCache = registryData().diskCache;
+        if (!diskCache.isOpen()) {
+                if (!image.o_ptr->load(file))
+                        return RkImage();
+                return image;
+        }
+
+        // Keyed by the file content, an edited file is decoded again.
+        std::vector<unsigned char> content;
+        if (!readFile(file, content)) {
+                RK_LOG_ERROR("can't read image file: " << file);
+                return RkImage();
+        }
+        auto hash = contentHash(content.data(), content.size());
+        auto cached = diskCache.find(hash, 1.0);
+        if (cached.data != nullptr) {
+                image.o_ptr->borrow(cached.size, cached.format, cached.data, cached.stride);
+                return image;
+        }
+
+        if (!image.o_ptr->load(file))
+                return RkImage();
+        diskCache.insert(hash, 1.0, image);
+        return image;
+}
+
+RkImage RkImageRegistry::image(const std::string &file)
+{
+        auto &registry = registryData();
+        auto mtime = modificationTime(file);
+        std::shared_future<RkImage> pending;
+        {
+                std::lock_guard<std::mutex> lock(registry.registryMutex);
+                RkImage image;
+                if (findFileEntry(registry, file, mtime, image)) {
+                        registry.hits++;
+                        return image;
+                }
+                registry.misses++;
+                auto res = registry.pendingFiles.find(file);
+                if (res != registry.pendingFiles.end())
+                        pending = res->second;
+        }
+
+        if (pending.valid())
+                return pending.get();
+
+        auto image = loadImage(file);
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        insertFileEntry(registry, file, mtime, image);
+        return image;
+}
+
+void RkImageRegistry::preload(const std::string &file)
+{
+        auto &registry = registryData();
+        auto mtime = modificationTime(file);
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        auto res = registry.fileIndex.find(file);
+        if ((res != registry.fileIndex.end() && res->second->modificationTime == mtime)
+            || registry.pendingFiles.find(file) != registry.pendingFiles.end())
+                return;
+
+        auto &tasks = registry.preloadTasks;
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const std::future<void> &task) {
+                                return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                        }), tasks.end());
+
+        auto promise = std::make_shared<std::promise<RkImage>>();
+        registry.pendingFiles.emplace(file, promise->get_future().share());
+        tasks.push_back(std::async(std::launch::async, [file, mtime, promise] {
+                                auto image = loadImage(file);
+                                auto &registry = registryData();
+                                {
+                                        std::lock_guard<std::mutex> lock(registry.registryMutex);
+                                        insertFileEntry(registry, file, mtime, image);
+                                        registry.pendingFiles.erase(file);
+                                }
+                                promise->set_value(image);
+                        }));
+}
+
+bool RkImageRegistry::setCacheFile(const std::string &file)
+{
+        return registryData().diskCache.open(file);
+}
+
+bool RkImageRegistry::syncCacheFile()
+{
+        return registryData().diskCache.sync();
+}
+
+void RkImageRegistry::setFileCacheSize(size_t bytes)
+{
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        registry.fileCacheLimit = bytes;
+        trimFileCache(registry);
+}
+
+size_t RkImageRegistry::fileCacheSize()
+{
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        return registry.fileCacheLimit;
+}
+
+size_t RkImageRegistry::collect()
+{
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        size_t freed = 0;
+        for (auto it = registry.contentIndex.begin(); it != registry.contentIndex.end();) {
+                if (it->second->image.o_ptr->useCount() == 1) {
+                        freed += imageBytes(it->second->image);
+                        it = registry.contentIndex.erase(it);
+                } else {
+                        ++it;
+                }
+        }
+
+        for (auto it = registry.pointerIndex.begin(); it != registry.pointerIndex.end();) {
+                if (it->second->image.o_ptr->useCount() == 1)
+                        it = registry.pointerIndex.erase(it);
+                else
+                        ++it;
+        }
+        return freed;
+}
+
+RkImageRegistry::Statistics RkImageRegistry::statistics()
+{
+        auto &registry = registryData();
+        std::lock_guard<std::mutex> lock(registry.registryMutex);
+        Statistics stats;
+        for (const auto &entry: registry.contentIndex) {
+                // The lazy resources keep only the encoded bytes until the first use.
+                if (entry.second->image.o_ptr->isDecoded())
+                        stats.bytesResident += imageBytes(entry.second->image);
+                else
+                        stats.bytesResident += entry.second->resourceSize;
+        }
+        stats.bytesResident += registry.fileCacheBytes;
+        stats.images = registry.contentIndex.size() + registry.fileCache.size();
+        stats.hits = registry.hits;
+        stats.misses = registry.misses;
+        return stats;
+}
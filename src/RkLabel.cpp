@@ -23,6 +23,7 @@
 
 #include "RkLabel.h"
 #include "RkLabelImpl.h"
+#include "RkImageRegistry.h"
 #include "RkLog.h"
 
 RkLabel::RkLabel(RkWidget *parent, const std::string &text)
@@ -42,6 +43,11 @@ std::string RkLabel::text() const
      return impl_ptr->text();
 }
 
+void RkLabel::setImage(const std::string &file)
+{
+        impl_ptr->setImage(RkImageRegistry::image(file));
+}
+
 void RkLabel::setImage(const RkImage &image)
 {
         impl_ptr->setImage(image);
@@ -0,0 +1,69 @@
+/**
+ * File name: RkLayoutSpace.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkLayoutSpace.h"
+
+#include <algorithm>
+
+void RkLayoutSpace::distribute(std::vector<RkLayoutSlot> &slots, int space)
+{
+        long long extra = space - length(slots);
+        auto canChange = [&extra](const RkLayoutSlot &slot) {
+                if (slot.stretch <= 0)
+                        return false;
+                return extra > 0 ? slot.length < slot.maximum : slot.length > slot.minimum;
+        };
+
+        // Each pass clamps at least one slot or takes all the space.
+        for (int pass = 0; pass < maxPasses && extra != 0; pass++) {
+                long long stretch = 0;
+                for (const auto &slot: slots) {
+                        if (canChange(slot))
+                                stretch += slot.stretch;
+                }
+                if (stretch == 0)
+                        break;
+
+                for (auto &slot: slots) {
+                        if (extra == 0)
+                                break;
+                        if (!canChange(slot))
+                                continue;
+                        auto share = extra * slot.stretch / stretch;
+                        stretch -= slot.stretch;
+                        auto newLength = std::clamp(static_cast<long long>(slot.length) + share,
+                                                    static_cast<long long>(slot.minimum),
+                                                    static_cast<long long>(std::max(slot.maximum, slot.minimum)));
+                        extra -= newLength - slot.length;
+                        slot.length = static_cast<int>(newLength);
+                }
+        }
+}
+
+int RkLayoutSpace::length(const std::vector<RkLayoutSlot> &slots)
+{
+        long long n = 0;
+        for (const auto &slot: slots)
+                n += slot.length;
+        return static_cast<int>(std::min(n, 1000000000LL));
+}
@@ -33,6 +33,36 @@ RkList::RkList(RkWidget *parent, RkModel *model)
         , impl_ptr{static_cast<RkList::RkListImpl*>(o_ptr.get())}
 {
         RK_ACT_BIND(getModel(), modelChanged, RK_ACT_ARGS(), this, update());
+        RK_ACT_BIND(getModel(), itemsChanged, RK_ACT_ARGS(size_t first, size_t last, int role),
+                    this, onItemsChanged(first, last));
+        RK_ACT_BIND(getModel(), itemsInserted, RK_ACT_ARGS(size_t first, size_t last),
+                    this, onItemsInserted(first, last));
+        RK_ACT_BIND(getModel(), itemsRemoved, RK_ACT_ARGS(size_t first, size_t last),
+                    this, onItemsRemoved(first, last));
+}
+
+void RkList::onItemsChanged(size_t first, size_t last)
+{
+        if (impl_ptr->itemsChanged(first, last))
+                update();
+}
+
+void RkList::onItemsInserted(size_t first, size_t last)
+{
+        auto offset = scrollOffset();
+        if (impl_ptr->itemsInserted(first, last))
+                update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+void RkList::onItemsRemoved(size_t first, size_t last)
+{
+        auto offset = scrollOffset();
+        if (impl_ptr->itemsRemoved(first, last) || scrollOffset() != offset)
+                update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
 }
 
 RkModel* RkList::getModel() const
@@ -40,6 +70,34 @@ RkModel* RkList::getModel() const
         return impl_ptr->getModel();
 }
 
+int RkList::scrollOffset() const
+{
+        return impl_ptr->scrollOffset();
+}
+
+void RkList::setScrollOffset(int offset)
+{
+        if (impl_ptr->setScrollOffset(offset)) {
+                update();
+                action scrollOffsetChanged(scrollOffset());
+        }
+}
+
+int RkList::maxScrollOffset() const
+{
+        return impl_ptr->maxScrollOffset();
+}
+
+void RkList::scrollToItem(size_t index)
+{
+        setScrollOffset(impl_ptr->scrollOffsetForItem(index));
+}
+
+size_t RkList::itemAt(int y) const
+{
+        return impl_ptr->getIndex(y);
+}
+
 void RkList::paintEvent(RkPaintEvent *event)
 {
         RkImage img(size());
@@ -64,8 +122,22 @@ void RkList::mouseMoveEvent(RkMouseEvent *event)
 
 void RkList::mouseButtonPressEvent(RkMouseEvent *event)
 {
-        if (event->button() == RkMouseEvent::ButtonType::Left)
-                getModel()->selectItem(impl_ptr->getIndex(event->y()));
+        auto span = getModel() ? getModel()->itemSpan() : 0;
+        switch (event->button())
+        {
+        case RkMouseEvent::ButtonType::Left:
+                if (getModel())
+                        getModel()->selectItem(itemAt(event->y()));
+                break;
+        case RkMouseEvent::ButtonType::WheelUp:
+                setScrollOffset(scrollOffset() - 3 * span);
+                break;
+        case RkMouseEvent::ButtonType::WheelDown:
+                setScrollOffset(scrollOffset() + 3 * span);
+                break;
+        default:
+                break;
+        }
 }
 
 void RkList::mouseButtonReleaseEvent(RkMouseEvent *event)
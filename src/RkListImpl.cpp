@@ -25,6 +25,9 @@
 #include "RkLog.h"
 #include "RkModel.h"
 
+#include <algorithm>
+#include <limits>
+
 RkList::RkListImpl::RkListImpl(RkList *interface,
                                RkWidget *parent, RkModel *model)
     : RkWidgetImpl(static_cast<RkWidget*>(interface), parent)
@@ -32,41 +35,59 @@ RkList::RkListImpl::RkListImpl(RkList *interface,
     , listModel{model}
     , topMargin{0}
     , leftMargin{10}
+    , listScrollOffset{0}
 {
 }
 
+/**
+ * Draws only the items that intersect the clip. Each item starts with
+ * the painter pen and font, so the result doesn't depend on the items
+ * above it that were not drawn.
+ */
 void RkList::RkListImpl::drawList(RkPainter &painter)
 {
-        int y = topMargin;
-        size_t i = 0;
-        RkPen pen = painter.pen();
-        while (i < listModel->itemsNumber()) {
-                RkVariant itemData = listModel->itemData(i, static_cast<int>(RkModelItem::DataType::Color));
-                if (std::holds_alternative<RkColor>(itemData)) {
-                        pen.setColor(std::get<RkColor>(itemData));
-                        painter.setPen(pen);
-                }
+        if (!listModel || listModel->itemSpan() < 1 || listModel->itemsNumber() < 1)
+                return;
 
-                itemData = listModel->itemData(i, static_cast<int>(RkModelItem::DataType::Font));
-                if (std::holds_alternative<RkFont>(itemData))
-                        painter.setFont(std::get<RkFont>(itemData));
+        setScrollOffset(listScrollOffset);
+        auto span = listModel->itemSpan();
+        auto bounds = painter.clipBounds();
+        auto top = std::max(bounds.top(), 0) + listScrollOffset - topMargin;
+        auto bottom = std::min(bounds.bottom(), inf_ptr->height()) + listScrollOffset - topMargin;
+        if (bottom <= 0)
+                return;
 
-                if  (listModel->isItemSelected(i)) {
-                        pen.setColor({255, 255, 255});
-                        painter.setPen(pen);
-                }
+        auto first = static_cast<size_t>(std::max(top, 0) / span);
+        auto last = std::min(static_cast<size_t>((bottom + span - 1) / span), listModel->itemsNumber());
+        if (first >= last)
+                return;
 
-                itemData = listModel->itemData(i, static_cast<int>(RkModelItem::DataType::String));
-                if (std::holds_alternative<std::string>(itemData)) {
-                        RkFont font = painter.font();
-                        painter.drawText(RkRect(leftMargin, y, inf_ptr->width() - leftMargin, listModel->itemSpan()),
-                                         std::get<std::string>(itemData),
+        const RkPen defaultPen = painter.pen();
+        const RkFont defaultFont = painter.font();
+        visibleRows.resize(last - first);
+        listModel->itemsData(first, visibleRows.size(),
+                             RkModel::dataTypeMask(RkModelItem::DataType::String)
+                             | RkModel::dataTypeMask(RkModelItem::DataType::Color)
+                             | RkModel::dataTypeMask(RkModelItem::DataType::Font),
+                             visibleRows.data());
+        for (auto i = first; i < last; i++) {
+                const auto &row = visibleRows[i - first];
+                RkPen pen = defaultPen;
+                if (row.hasColor)
+                        pen.setColor(row.color);
+                if  (listModel->isItemSelected(i))
+                        pen.setColor({255, 255, 255});
+                painter.setPen(pen);
+                painter.setFont(row.font ? *row.font : defaultFont);
+                if (!row.text.empty()) {
+                        int y = topMargin + static_cast<int>(i) * span - listScrollOffset;
+                        painter.drawText(RkRect(leftMargin, y, inf_ptr->width() - leftMargin, span),
+                                         row.text,
                                          Rk::Alignment::AlignLeft);
                 }
-
-                y += listModel->itemSpan();
-                i++;
         }
+        painter.setPen(defaultPen);
+        painter.setFont(defaultFont);
 }
 
 RkModel* RkList::RkListImpl::getModel() const
@@ -76,7 +97,104 @@ RkModel* RkList::RkListImpl::getModel() const
 
 size_t RkList::RkListImpl::getIndex(int y) const
 {
-        if (listModel->itemSpan() > 0)
-                return (y - topMargin) / listModel->itemSpan();
-        return -1;
+        if (!listModel || listModel->itemSpan() < 1)
+                return -1;
+
+        auto pos = y + listScrollOffset - topMargin;
+        if (pos < 0)
+                return -1;
+
+        auto index = static_cast<size_t>(pos / listModel->itemSpan());
+        if (index >= listModel->itemsNumber())
+                return -1;
+        return index;
+}
+
+int RkList::RkListImpl::scrollOffset() const
+{
+        return listScrollOffset;
+}
+
+bool RkList::RkListImpl::setScrollOffset(int offset)
+{
+        offset = std::clamp(offset, 0, maxScrollOffset());
+        if (offset == listScrollOffset)
+                return false;
+        listScrollOffset = offset;
+        return true;
+}
+
+int RkList::RkListImpl::maxScrollOffset() const
+{
+        if (!listModel)
+                return 0;
+        auto contentHeight = static_cast<long long>(listModel->itemsNumber()) * listModel->itemSpan() + topMargin;
+        auto offset = contentHeight - inf_ptr->height();
+        return static_cast<int>(std::clamp<long long>(offset, 0, std::numeric_limits<int>::max()));
+}
+
+int RkList::RkListImpl::scrollOffsetForItem(size_t index) const
+{
+        if (!listModel || index >= listModel->itemsNumber())
+                return listScrollOffset;
+
+        auto span = listModel->itemSpan();
+        auto top = topMargin + static_cast<int>(index) * span;
+        if (top < listScrollOffset)
+                return top;
+        if (top + span > listScrollOffset + inf_ptr->height())
+                return top + span - inf_ptr->height();
+        return listScrollOffset;
+}
+
+std::pair<size_t, size_t> RkList::RkListImpl::visibleItems() const
+{
+        if (!listModel || listModel->itemSpan() < 1)
+                return {0, 0};
+
+        auto span = listModel->itemSpan();
+        auto top = std::max(listScrollOffset - topMargin, 0);
+        auto bottom = listScrollOffset + inf_ptr->height() - topMargin;
+        if (bottom <= 0)
+                return {0, 0};
+        auto first = static_cast<size_t>(top / span);
+        auto last = std::min(static_cast<size_t>((bottom + span - 1) / span), listModel->itemsNumber());
+        return {first, std::max(first, last)};
+}
+
+bool RkList::RkListImpl::itemsChanged(size_t first, size_t last) const
+{
+        auto visible = visibleItems();
+        return first < visible.second && last >= visible.first;
+}
+
+/**
+ * Items inserted above the visible ones move the scroll offset with them,
+ * so the visible items stay in place.
+ */
+bool RkList::RkListImpl::itemsInserted(size_t first, size_t last)
+{
+        auto visible = visibleItems();
+        if (first < visible.first) {
+                auto count = static_cast<int>(last - first + 1);
+                setScrollOffset(listScrollOffset + count * listModel->itemSpan());
+                return false;
+        }
+        return first < visible.second || visible.first == visible.second;
+}
+
+bool RkList::RkListImpl::itemsRemoved(size_t first, size_t last)
+{
+        auto visible = visibleItems();
+        auto span = listModel->itemSpan();
+        if (last < visible.first) {
+                auto count = static_cast<int>(last - first + 1);
+                setScrollOffset(listScrollOffset - count * span);
+                return false;
+        }
+        if (first < visible.first)
+                setScrollOffset(topMargin + static_cast<int>(first) * span);
+        else
+                setScrollOffset(listScrollOffset);
+        return true;
 }
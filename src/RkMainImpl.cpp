@@ -26,6 +26,7 @@
 #include "RkMainImpl.h"
 #include "RkPlatform.h"
 #include "RkEventQueue.h"
+#include "RkImageRegistry.h"
 
 #include <chrono>
 #include <thread>
@@ -93,6 +94,7 @@ int RkMain::RkMainImpl::exec(bool block)
                                 break;
                         std::this_thread::sleep_for(std::chrono::milliseconds(1));
                 }
+                RkImageRegistry::syncCacheFile();
         }
 
         return 0;
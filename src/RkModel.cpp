@@ -35,6 +35,52 @@ RkModel::RkModel(RkObject *parent)
 {
 }
 
+RkModel::RkModel(RkObject *parent, std::unique_ptr<RkModelImpl> impl)
+        : RkObject(parent, std::move(impl))
+        , impl_ptr{static_cast<RkModel::RkModelImpl*>(o_ptr.get())}
+{
+}
+
+void RkModel::itemsData(size_t first, size_t count, int dataTypes, RkModelRow *rows) const
+{
+        for (size_t i = 0; i < count; i++) {
+                auto &row = rows[i];
+                auto index = first + i;
+                row.text = std::string_view();
+                row.hasColor = false;
+                row.font = nullptr;
+                if (dataTypes & dataTypeMask(RkModelItem::DataType::String))
+                        itemsText(index, 1, static_cast<int>(RkModelItem::DataType::String), &row);
+                if (dataTypes & dataTypeMask(RkModelItem::DataType::Color)) {
+                        auto data = itemData(index, static_cast<int>(RkModelItem::DataType::Color));
+                        if (std::holds_alternative<RkColor>(data)) {
+                                row.color = std::get<RkColor>(data);
+                                row.hasColor = true;
+                        }
+                }
+                if (dataTypes & dataTypeMask(RkModelItem::DataType::Font)) {
+                        auto data = itemData(index, static_cast<int>(RkModelItem::DataType::Font));
+                        if (std::holds_alternative<RkFont>(data)) {
+                                row.fontStorage = std::move(std::get<RkFont>(data));
+                                row.font = &row.fontStorage;
+                        }
+                }
+        }
+}
+
+void RkModel::itemsText(size_t first, size_t count, int dataType, RkModelRow *rows) const
+{
+        for (size_t i = 0; i < count; i++) {
+                auto &row = rows[i];
+                row.text = std::string_view();
+                auto data = itemData(first + i, dataType);
+                if (std::holds_alternative<std::string>(data)) {
+                        row.textStorage = std::move(std::get<std::string>(data));
+                        row.text = row.textStorage;
+                }
+        }
+}
+
 bool RkModel::isItemSelected(size_t index) const
 {
         return impl_ptr->isItemSelected(index);
@@ -43,8 +89,11 @@ bool RkModel::isItemSelected(size_t index) const
 void RkModel::selectItem(size_t index)
 {
         if (isValidIndex(index)) {
+                auto previous = impl_ptr->selectedItem();
                 impl_ptr->selectItem(index);
-                action modelChanged();
+                if (isValidIndex(previous) && previous != index)
+                        notifyItemsChanged(previous, previous);
+                notifyItemsChanged(index, index);
                 action itemSelected(RkModelItem(this, index));
         }
 }
@@ -54,3 +103,58 @@ bool RkModel::isValidIndex(size_t index) const
         return index < itemsNumber();
 }
 
+void RkModel::beginUpdate()
+{
+        impl_ptr->beginUpdate();
+}
+
+/**
+ * Sends the changes made since beginUpdate(). Inserted or removed items
+ * are sent as modelChanged, because the indexes of the other changes
+ * may not be valid anymore.
+ */
+void RkModel::endUpdate()
+{
+        if (!impl_ptr->endUpdate())
+                return;
+
+        bool reset = impl_ptr->hasStructureChange();
+        size_t first, last;
+        int role;
+        bool changed = impl_ptr->takeItemsChange(first, last, role);
+        if (reset)
+                action modelChanged();
+        else if (changed)
+                action itemsChanged(first, last, role);
+}
+
+bool RkModel::isUpdating() const
+{
+        return impl_ptr->isUpdating();
+}
+
+void RkModel::notifyItemsInserted(size_t first, size_t last)
+{
+        if (first > last)
+                return;
+        impl_ptr->itemsInserted(first, last);
+        if (!impl_ptr->deferStructureChange())
+                action itemsInserted(first, last);
+}
+
+void RkModel::notifyItemsRemoved(size_t first, size_t last)
+{
+        if (first > last)
+                return;
+        impl_ptr->itemsRemoved(first, last);
+        if (!impl_ptr->deferStructureChange())
+                action itemsRemoved(first, last);
+}
+
+void RkModel::notifyItemsChanged(size_t first, size_t last, int role)
+{
+        if (first > last)
+                return;
+        if (!impl_ptr->deferItemsChange(first, last, role))
+                action itemsChanged(first, last, role);
+}
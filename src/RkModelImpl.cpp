@@ -23,10 +23,18 @@
 
 #include "RkModelImpl.h"
 
+#include <algorithm>
+
 RkModel::RkModelImpl::RkModelImpl(RkModel* interface, RkObject* parent)
         : RkObjectImpl(interface, parent)
         , inf_ptr{interface}
         , selectedIndex(-1)
+        , updateLevel{0}
+        , structureChanged{false}
+        , itemsChangePending{false}
+        , changedFirst{0}
+        , changedLast{0}
+        , changedRole{-1}
 {
 }
 
@@ -39,3 +47,84 @@ void RkModel::RkModelImpl::selectItem(size_t index)
 {
         selectedIndex = index;
 }
+
+size_t RkModel::RkModelImpl::selectedItem() const
+{
+        return selectedIndex;
+}
+
+void RkModel::RkModelImpl::itemsInserted(size_t first, size_t last)
+{
+        if (selectedIndex != static_cast<size_t>(-1) && selectedIndex >= first)
+                selectedIndex += last - first + 1;
+}
+
+void RkModel::RkModelImpl::itemsRemoved(size_t first, size_t last)
+{
+        if (selectedIndex == static_cast<size_t>(-1) || selectedIndex < first)
+                return;
+        if (selectedIndex <= last)
+                selectedIndex = -1;
+        else
+                selectedIndex -= last - first + 1;
+}
+
+void RkModel::RkModelImpl::beginUpdate()
+{
+        updateLevel++;
+}
+
+bool RkModel::RkModelImpl::endUpdate()
+{
+        if (updateLevel < 1)
+                return false;
+        return --updateLevel == 0;
+}
+
+bool RkModel::RkModelImpl::isUpdating() const
+{
+        return updateLevel > 0;
+}
+
+bool RkModel::RkModelImpl::deferStructureChange()
+{
+        if (!isUpdating())
+                return false;
+        structureChanged = true;
+        return true;
+}
+
+bool RkModel::RkModelImpl::deferItemsChange(size_t first, size_t last, int role)
+{
+        if (!isUpdating())
+                return false;
+
+        if (!itemsChangePending) {
+                changedFirst = first;
+                changedLast = last;
+                changedRole = role;
+                itemsChangePending = true;
+        } else {
+                changedFirst = std::min(changedFirst, first);
+                changedLast = std::max(changedLast, last);
+                if (changedRole != role)
+                        changedRole = -1;
+        }
+        return true;
+}
+
+bool RkModel::RkModelImpl::hasStructureChange() const
+{
+        return structureChanged;
+}
+
+bool RkModel::RkModelImpl::takeItemsChange(size_t &first, size_t &last, int &role)
+{
+        bool pending = itemsChangePending;
+        first = changedFirst;
+        last = changedLast;
+        role = changedRole;
+        itemsChangePending = false;
+        structureChanged = false;
+        return pending;
+}
@@ -23,6 +23,8 @@
 
 #include "RkPainter.h"
 #include "RkPainterImpl.h"
+#include "RkImageRegistry.h"
+#include "RkLog.h"
 
 RkPainter::RkPainter(RkCanvas *canvas)
         : o_ptr{std::make_unique<RkPainterImpl>(this, canvas)}
@@ -33,19 +35,19 @@ RkPainter::~RkPainter()
 {
 }
 
-void RkPainter::drawText(int x, int y, const std::string &text)
+void RkPainter::drawText(int x, int y, std::string_view text)
 {
         if (!text.empty())
                 o_ptr->drawText(text, x, y);
 }
 
-void RkPainter::drawText(const RkPoint &p,  const std::string &text)
+void RkPainter::drawText(const RkPoint &p, std::string_view text)
 {
         drawText(p.x(), p.y(), text);
 }
 
 void RkPainter::drawText(const RkRect &rect,
-                         const std::string &text,
+                         std::string_view text,
                          Rk::Alignment alignment)
 {
         if (!text.empty()) {
@@ -64,10 +66,33 @@ void RkPainter::drawText(const RkRect &rect,
 
 void RkPainter::drawImage(const RkImage &image, int x, int y)
 {
-        if (!image.isNull())
+        if (!image.isNull() && o_ptr->isVisible(RkRect(RkPoint(x, y), image.size())))
                 o_ptr->drawImage(image, x, y);
 }
 
+void RkPainter::drawImage(const std::string &file, int x, int y)
+{
+        if (!file.empty())
+                drawImage(RkImageRegistry::image(file), x, y);
+}
+
+void RkPainter::drawImage(const RkImageRegion &region, int x, int y)
+{
+        if (!region.isNull() && o_ptr->isVisible(RkRect(RkPoint(x, y), region.rect().size())))
+                o_ptr->drawImage(region.image(), region.rect(), x, y);
+}
+
+void RkPainter::drawMask(const RkImage &mask, int x, int y)
+{
+        drawMask(mask, x, y, pen().color());
+}
+
+void RkPainter::drawMask(const RkImage &mask, int x, int y, const RkColor &color)
+{
+        if (!mask.isNull() && o_ptr->isVisible(RkRect(RkPoint(x, y), mask.size())))
+                o_ptr->drawMask(mask, x, y, color);
+}
+
 void RkPainter::drawCircle(int x, int y, int radius)
 {
         if (radius > 0)
@@ -94,7 +119,12 @@ void RkPainter::drawLine(const RkPoint &p1, const RkPoint &p2)
 
 void RkPainter::drawRect(const RkRect &rect)
 {
-        o_ptr->drawRect(rect);
+        // The stroke goes outside of the rectangle by up to the pen width.
+        auto w = pen().width() + 1;
+        if (o_ptr->isVisible(RkRect(rect.left() - w, rect.top() - w,
+                                    rect.width() + 2 * w, rect.height() + 2 * w))) {
+                o_ptr->drawRect(rect);
+        }
 }
 
 void RkPainter::drawPolyline(const std::vector<RkPoint> &points)
@@ -103,12 +133,92 @@ void RkPainter::drawPolyline(const std::vector<RkPoint> &points)
                 o_ptr->drawPolyline(points);
 }
 
+void RkPainter::drawPath(const RkPath &path)
+{
+        if (path.isEmpty())
+                return;
+
+        auto bounds = path.boundingRect();
+        auto w = pen().width() + 1;
+        if (o_ptr->isVisible(RkRect(bounds.left() - w, bounds.top() - w,
+                                    bounds.width() + 2 * w, bounds.height() + 2 * w))) {
+                o_ptr->drawPath(path);
+        }
+}
+
+void RkPainter::fillPath(const RkPath &path)
+{
+        fillPath(path, pen().color());
+}
+
+void RkPainter::fillPath(const RkPath &path, const RkColor &color)
+{
+        if (!path.isEmpty() && o_ptr->isVisible(path.boundingRect()))
+                o_ptr->fillPath(path, color);
+}
+
 void RkPainter::fillRect(const RkRect &rect, const RkColor &color)
 {
-        if (rect.area() > 0)
+        if (rect.area() > 0 && o_ptr->isVisible(rect))
                 o_ptr->fillRect(rect, color);
 }
 
+void RkPainter::drawLines(const std::vector<RkPoint> &points)
+{
+        if (points.size() > 1)
+                o_ptr->drawLines(points, {});
+}
+
+void RkPainter::drawLines(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors)
+{
+        if (colors.size() != points.size() / 2)
+                RK_LOG_ERROR("wrong number of colors");
+        else if (points.size() > 1)
+                o_ptr->drawLines(points, colors);
+}
+
+void RkPainter::drawRects(const std::vector<RkRect> &rects)
+{
+        if (!rects.empty())
+                o_ptr->drawRects(rects, {});
+}
+
+void RkPainter::drawRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors)
+{
+        if (colors.size() != rects.size())
+                RK_LOG_ERROR("wrong number of colors");
+        else if (!rects.empty())
+                o_ptr->drawRects(rects, colors);
+}
+
+void RkPainter::fillRects(const std::vector<RkRect> &rects, const RkColor &color)
+{
+        if (!rects.empty())
+                o_ptr->fillRects(rects, {color});
+}
+
+void RkPainter::fillRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors)
+{
+        if (colors.size() != rects.size())
+                RK_LOG_ERROR("wrong number of colors");
+        else if (!rects.empty())
+                o_ptr->fillRects(rects, colors);
+}
+
+void RkPainter::drawPoints(const std::vector<RkPoint> &points)
+{
+        if (!points.empty())
+                o_ptr->drawPoints(points, {});
+}
+
+void RkPainter::drawPoints(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors)
+{
+        if (colors.size() != points.size())
+                RK_LOG_ERROR("wrong number of colors");
+        else if (!points.empty())
+                o_ptr->drawPoints(points, colors);
+}
+
 void RkPainter::applyAlpha(int alpha)
 {
         o_ptr->applyAlpha(alpha);
@@ -144,7 +254,44 @@ void RkPainter::rotate(rk_real angle)
         o_ptr->rotate(angle);
 }
 
-int RkPainter::getTextWidth(const std::string &text) const
+void RkPainter::save()
+{
+        o_ptr->save();
+}
+
+void RkPainter::restore()
+{
+        o_ptr->restore();
+}
+
+void RkPainter::setClipRect(const RkRect &rect)
+{
+        o_ptr->setClip({rect});
+}
+
+void RkPainter::setClipRegion(const std::vector<RkRect> &rects)
+{
+        o_ptr->setClip(rects);
+}
+
+RkRect RkPainter::clipBounds() const
+{
+        return o_ptr->clipBounds();
+}
+
+int RkPainter::getTextWidth(std::string_view text) const
 {
         return o_ptr->getTextWidth(text);
 }
+
+void RkPainter::drawPicture(const RkPicture &picture, int x, int y)
+{
+        if (!picture.isEmpty())
+                o_ptr->drawPicture(picture, RkRect(), x, y);
+}
+
+void RkPainter::drawPicture(const RkPicture &picture, const RkRect &source, int x, int y)
+{
+        if (!picture.isEmpty() && source.area() > 0)
+                o_ptr->drawPicture(picture, source, x, y);
+}
@@ -22,64 +22,161 @@
  */
 
 #include "RkPainterImpl.h"
+#include "RkPictureImpl.h"
 #include "RkCairoGraphicsBackend.h"
 #include "RkLog.h"
 
 RkPainter::RkPainterImpl::RkPainterImpl(RkPainter* interface, RkCanvas* canvas)
         : inf_ptr{interface}
+        , pictureRecorder{nullptr}
+        , clipRectValid{false}
+{
+        RK_UNUSED(inf_ptr);
+        auto picture = dynamic_cast<RkPicture*>(canvas);
+        if (picture) {
+                // The drawing is recorded, the backend is kept only
+                // for text metrics, transformation and clip.
+                picture->beginPaint();
+                pictureRecorder = picture->o_ptr.get();
+        }
 #ifdef RK_GRAPHICS_CAIRO_BACKEND
-        , backendGraphics{std::make_unique<RkCairoGraphicsBackend>(canvas)}
+        if (pictureRecorder)
+                backendGraphics = std::make_unique<RkCairoGraphicsBackend>();
+        else
+                backendGraphics = std::make_unique<RkCairoGraphicsBackend>(canvas);
 #else
 #error No graphics backend defined
 #endif
-{
-        RK_UNUSED(inf_ptr);
         backendGraphics->setPen(painterPen);
         backendGraphics->setFont(painterFont);
+        if (pictureRecorder) {
+                pictureRecorder->setPen(painterPen);
+                pictureRecorder->setFont(painterFont);
+        }
 }
 
 RkPainter::RkPainterImpl::~RkPainterImpl()
 {
 }
 
-void RkPainter::RkPainterImpl::drawText(const std::string &text, int x, int y)
+void RkPainter::RkPainterImpl::drawText(std::string_view text, int x, int y)
 {
-        backendGraphics->drawText(text, x, y);
+        if (pictureRecorder)
+                pictureRecorder->drawText(text, x, y);
+        else
+                backendGraphics->drawText(text, x, y);
 }
 
-void RkPainter::RkPainterImpl::drawImage(const std::string &file, int x, int y)
+void RkPainter::RkPainterImpl::drawImage(const RkImage &image, int x, int y)
 {
-        backendGraphics->drawImage(file, x, y);
+        if (pictureRecorder)
+                pictureRecorder->drawImage(image, x, y);
+        else
+                backendGraphics->drawImage(image, x, y);
 }
 
-void RkPainter::RkPainterImpl::drawImage(const RkImage &image, int x, int y)
+void RkPainter::RkPainterImpl::drawImage(const RkImage &image, const RkRect &source, int x, int y)
 {
-        backendGraphics->drawImage(image, x, y);
+        if (pictureRecorder)
+                pictureRecorder->drawImage(image, source, x, y);
+        else
+                backendGraphics->drawImage(image, source, x, y);
+}
+
+void RkPainter::RkPainterImpl::drawMask(const RkImage &mask, int x, int y, const RkColor &color)
+{
+        if (pictureRecorder)
+                pictureRecorder->drawMask(mask, x, y, color);
+        else
+                backendGraphics->drawMask(mask, x, y, color);
 }
 
 void RkPainter::RkPainterImpl::drawEllipse(const RkPoint& p, int width, int height)
 {
-        backendGraphics->drawEllipse(p, width, height);
+        if (pictureRecorder)
+                pictureRecorder->drawEllipse(p, width, height);
+        else
+                backendGraphics->drawEllipse(p, width, height);
 }
 
 void RkPainter::RkPainterImpl::drawLine(const RkPoint &p1, const RkPoint &p2)
 {
-        backendGraphics->drawLine(p1, p2);
+        if (pictureRecorder)
+                pictureRecorder->drawLine(p1, p2);
+        else
+                backendGraphics->drawLine(p1, p2);
 }
 
 void RkPainter::RkPainterImpl::drawRect(const RkRect &rect)
 {
-        backendGraphics->drawRect(rect);
+        if (pictureRecorder)
+                pictureRecorder->drawRect(rect);
+        else
+                backendGraphics->drawRect(rect);
 }
 
 void RkPainter::RkPainterImpl::drawPolyline(const std::vector<RkPoint> &points)
 {
-        backendGraphics->drawPolyLine(points);
+        if (pictureRecorder)
+                pictureRecorder->drawPolyline(points);
+        else
+                backendGraphics->drawPolyLine(points);
+}
+
+void RkPainter::RkPainterImpl::drawPath(const RkPath &path)
+{
+        if (pictureRecorder)
+                pictureRecorder->drawPath(path);
+        else
+                backendGraphics->drawPath(path);
+}
+
+void RkPainter::RkPainterImpl::fillPath(const RkPath &path, const RkColor &color)
+{
+        if (pictureRecorder)
+                pictureRecorder->fillPath(path, color);
+        else
+                backendGraphics->fillPath(path, color);
 }
 
 void RkPainter::RkPainterImpl::fillRect(const RkRect &rect, const RkColor &color)
 {
-        backendGraphics->fillRect(rect, color);
+        if (pictureRecorder)
+                pictureRecorder->fillRect(rect, color);
+        else
+                backendGraphics->fillRect(rect, color);
+}
+
+void RkPainter::RkPainterImpl::drawLines(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors)
+{
+        if (pictureRecorder)
+                pictureRecorder->drawLines(points, colors);
+        else
+                backendGraphics->drawLines(points, colors);
+}
+
+void RkPainter::RkPainterImpl::drawRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors)
+{
+        if (pictureRecorder)
+                pictureRecorder->drawRects(rects, colors);
+        else
+                backendGraphics->drawRects(rects, colors);
+}
+
+void RkPainter::RkPainterImpl::fillRects(const std::vector<RkRect> &rects, const std::vector<RkColor> &colors)
+{
+        if (pictureRecorder)
+                pictureRecorder->fillRects(rects, colors);
+        else
+                backendGraphics->fillRects(rects, colors);
+}
+
+void RkPainter::RkPainterImpl::drawPoints(const std::vector<RkPoint> &points, const std::vector<RkColor> &colors)
+{
+        if (pictureRecorder)
+                pictureRecorder->drawPoints(points, colors);
+        else
+                backendGraphics->drawPoints(points, colors);
 }
 
 const RkPen& RkPainter::RkPainterImpl::pen() const
@@ -90,6 +187,8 @@ const RkPen& RkPainter::RkPainterImpl::pen() const
 void RkPainter::RkPainterImpl::setPen(const RkPen &pen)
 {
         backendGraphics->setPen(pen);
+        if (pictureRecorder)
+                pictureRecorder->setPen(pen);
         painterPen = pen;
 }
 
@@ -102,24 +201,94 @@ void RkPainter::RkPainterImpl::setFont(const RkFont &font)
 {
         painterFont = font;
         backendGraphics->setFont(painterFont);
+        if (pictureRecorder)
+                pictureRecorder->setFont(painterFont);
 }
 
 void RkPainter::RkPainterImpl::translate(const RkPoint &offset)
 {
         backendGraphics->translate(offset);
+        if (pictureRecorder)
+                pictureRecorder->translate(offset);
+        transformChanged();
 }
 
 void RkPainter::RkPainterImpl::rotate(rk_real angle)
 {
         backendGraphics->rotate(angle);
+        if (pictureRecorder)
+                pictureRecorder->rotate(angle);
+        transformChanged();
 }
 
-int RkPainter::RkPainterImpl::getTextWidth(const std::string &text) const
+int RkPainter::RkPainterImpl::getTextWidth(std::string_view text) const
 {
         return backendGraphics->getTextWidth(text);
 }
 
 void RkPainter::RkPainterImpl::applyAlpha(int alpha)
 {
-        backendGraphics->applyAlpha(alpha);
+        if (pictureRecorder)
+                pictureRecorder->applyAlpha(alpha);
+        else
+                backendGraphics->applyAlpha(alpha);
+}
+
+void RkPainter::RkPainterImpl::drawPicture(const RkPicture &picture, const RkRect &source, int x, int y)
+{
+        if (pictureRecorder)
+                pictureRecorder->drawPicture(picture, source, x, y);
+        else
+                picture.o_ptr->replay(backendGraphics.get(), source, x, y);
+}
+
+void RkPainter::RkPainterImpl::save()
+{
+        backendGraphics->save();
+        if (pictureRecorder)
+                pictureRecorder->save();
+        statesStack.push_back({painterPen, painterFont});
+}
+
+void RkPainter::RkPainterImpl::restore()
+{
+        if (statesStack.empty()) {
+                RK_LOG_ERROR("restore without save");
+                return;
+        }
+
+        backendGraphics->restore();
+        if (pictureRecorder)
+                pictureRecorder->restore();
+        painterPen = statesStack.back().pen;
+        painterFont = statesStack.back().font;
+        statesStack.pop_back();
+        transformChanged();
+}
+
+void RkPainter::RkPainterImpl::setClip(const std::vector<RkRect> &rects)
+{
+        backendGraphics->clip(rects);
+        if (pictureRecorder)
+                pictureRecorder->clip(rects);
+        transformChanged();
+}
+
+RkRect RkPainter::RkPainterImpl::clipBounds() const
+{
+        if (!clipRectValid) {
+                clipRect = backendGraphics->clipBounds();
+                clipRectValid = true;
+        }
+        return clipRect;
+}
+
+bool RkPainter::RkPainterImpl::isVisible(const RkRect &rect) const
+{
+        return clipBounds().intersects(rect);
+}
+
+void RkPainter::RkPainterImpl::transformChanged()
+{
+        clipRectValid = false;
 }
@@ -0,0 +1,147 @@
+/**
+ * File name: RkPath.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPath.h"
+#include "RkPathImpl.h"
+
+#include <algorithm>
+#include <cmath>
+
+RkPath::RkPath()
+        : o_ptr{std::make_unique<RkPathImpl>(this)}
+{
+}
+
+RkPath::RkPath(const RkPath &path)
+        : o_ptr{std::make_unique<RkPathImpl>(this)}
+{
+        o_ptr->share(*path.o_ptr);
+}
+
+RkPath::RkPath(RkPath &&path)
+        : o_ptr{std::make_unique<RkPathImpl>(this)}
+{
+        o_ptr->take(*path.o_ptr);
+}
+
+RkPath::~RkPath()
+{
+}
+
+RkPath& RkPath::operator=(const RkPath &other)
+{
+        if (this != &other)
+                o_ptr->share(*other.o_ptr);
+        return *this;
+}
+
+RkPath& RkPath::operator=(RkPath &&other)
+{
+        if (this != &other)
+                o_ptr->take(*other.o_ptr);
+        return *this;
+}
+
+bool operator==(const RkPath &path1, const RkPath &path2)
+{
+        return path1.o_ptr->isEqual(*path2.o_ptr);
+}
+
+bool operator!=(const RkPath &path1, const RkPath &path2)
+{
+        return !(path1 == path2);
+}
+
+void RkPath::moveTo(const RkRealPoint &p)
+{
+        o_ptr->add(Element::MoveTo, {p.x(), p.y()});
+}
+
+void RkPath::lineTo(const RkRealPoint &p)
+{
+        o_ptr->add(Element::LineTo, {p.x(), p.y()});
+}
+
+void RkPath::curveTo(const RkRealPoint &c1, const RkRealPoint &c2, const RkRealPoint &p)
+{
+        o_ptr->add(Element::CurveTo, {c1.x(), c1.y(), c2.x(), c2.y(), p.x(), p.y()});
+}
+
+void RkPath::arcTo(const RkRealPoint &center, rk_real radius, rk_real startAngle, rk_real endAngle)
+{
+        if (radius > 0)
+                o_ptr->add(Element::ArcTo, {center.x(), center.y(), radius, startAngle, endAngle});
+}
+
+void RkPath::close()
+{
+        o_ptr->add(Element::Close, {});
+}
+
+void RkPath::addRect(const RkRect &rect)
+{
+        moveTo(rect.topLeft());
+        lineTo(rect.topRight());
+        lineTo(rect.bottomRight());
+        lineTo(rect.bottomLeft());
+        close();
+}
+
+void RkPath::addRoundedRect(const RkRect &rect, rk_real radius)
+{
+        radius = std::min({radius,
+                           static_cast<rk_real>(rect.width()) / 2,
+                           static_cast<rk_real>(rect.height()) / 2});
+        if (radius <= 0) {
+                addRect(rect);
+                return;
+        }
+
+        constexpr rk_real halfPi = M_PI / 2;
+        moveTo(RkRealPoint(rect.left() + radius, rect.top()));
+        arcTo(RkRealPoint(rect.right() - radius, rect.top() + radius), radius, -halfPi, 0);
+        arcTo(RkRealPoint(rect.right() - radius, rect.bottom() - radius), radius, 0, halfPi);
+        arcTo(RkRealPoint(rect.left() + radius, rect.bottom() - radius), radius, halfPi, 2 * halfPi);
+        arcTo(RkRealPoint(rect.left() + radius, rect.top() + radius), radius, 2 * halfPi, 3 * halfPi);
+        close();
+}
+
+void RkPath::clear()
+{
+        o_ptr->clear();
+}
+
+bool RkPath::isEmpty() const
+{
+        return o_ptr->isEmpty();
+}
+
+RkRect RkPath::boundingRect() const
+{
+        return o_ptr->boundingRect();
+}
+
+size_t RkPath::hash() const
+{
+        return o_ptr->hash();
+}
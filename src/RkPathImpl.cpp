@@ -0,0 +1,171 @@
+/**
+ * File name: RkPathImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPathImpl.h"
+
+#include <cmath>
+
+RkPath::RkPathImpl::RkPathImpl(RkPath *interface)
+        : inf_ptr{interface}
+        , pathData{std::make_shared<RkPathData>()}
+{
+        RK_UNUSED(inf_ptr);
+}
+
+RkPath::RkPathImpl::~RkPathImpl()
+{
+}
+
+void RkPath::RkPathImpl::share(const RkPathImpl &other)
+{
+        pathData = other.pathData;
+}
+
+void RkPath::RkPathImpl::take(RkPathImpl &other)
+{
+        pathData = std::move(other.pathData);
+        other.pathData = std::make_shared<RkPathData>();
+}
+
+/**
+ * Makes the data unique before writing. The cached values are not copied,
+ * they are computed again for the changed path.
+ */
+void RkPath::RkPathImpl::detach()
+{
+        if (pathData.use_count() > 1) {
+                auto data = std::make_shared<RkPathData>();
+                data->elements = pathData->elements;
+                data->values = pathData->values;
+                pathData = std::move(data);
+        } else {
+                pathData->boundsValid = false;
+                pathData->hash = 0;
+                pathData->cairoPath.reset();
+        }
+}
+
+void RkPath::RkPathImpl::add(Element element, std::initializer_list<rk_real> values)
+{
+        detach();
+        pathData->elements.push_back(element);
+        pathData->values.insert(pathData->values.end(), values);
+}
+
+void RkPath::RkPathImpl::clear()
+{
+        pathData = std::make_shared<RkPathData>();
+}
+
+bool RkPath::RkPathImpl::isEmpty() const
+{
+        return pathData->elements.empty();
+}
+
+bool RkPath::RkPathImpl::isEqual(const RkPathImpl &other) const
+{
+        if (pathData == other.pathData)
+                return true;
+        return pathData->elements == other.pathData->elements
+                && pathData->values == other.pathData->values;
+}
+
+RkRect RkPath::RkPathImpl::boundingRect() const
+{
+        std::lock_guard<std::mutex> lock(pathData->cacheMutex);
+        if (pathData->boundsValid)
+                return pathData->bounds;
+
+        rk_real minX = 0, minY = 0, maxX = 0, maxY = 0;
+        bool first = true;
+        auto addPoint = [&](rk_real x, rk_real y) {
+                if (first) {
+                        minX = maxX = x;
+                        minY = maxY = y;
+                        first = false;
+                } else {
+                        minX = std::min(minX, x);
+                        maxX = std::max(maxX, x);
+                        minY = std::min(minY, y);
+                        maxY = std::max(maxY, y);
+                }
+        };
+
+        const auto &v = pathData->values;
+        size_t i = 0;
+        for (auto element: pathData->elements) {
+                switch (element)
+                {
+                case Element::MoveTo:
+                case Element::LineTo:
+                        addPoint(v[i], v[i + 1]);
+                        i += 2;
+                        break;
+                case Element::CurveTo:
+                        addPoint(v[i], v[i + 1]);
+                        addPoint(v[i + 2], v[i + 3]);
+                        addPoint(v[i + 4], v[i + 5]);
+                        i += 6;
+                        break;
+                case Element::ArcTo:
+                        // The whole circle, it contains the arc.
+                        addPoint(v[i] - v[i + 2], v[i + 1] - v[i + 2]);
+                        addPoint(v[i] + v[i + 2], v[i + 1] + v[i + 2]);
+                        i += 5;
+                        break;
+                default:
+                        break;
+                }
+        }
+
+        pathData->bounds = RkRect(RkPoint(std::floor(minX), std::floor(minY)),
+                                  RkPoint(std::ceil(maxX), std::ceil(maxY)));
+        pathData->boundsValid = true;
+        return pathData->bounds;
+}
+
+// FNV-1a
+size_t RkPath::RkPathImpl::hash() const
+{
+        std::lock_guard<std::mutex> lock(pathData->cacheMutex);
+        if (pathData->hash != 0)
+                return pathData->hash;
+
+        uint64_t h = 14695981039346656037ULL;
+        auto addBytes = [&h](const void *data, size_t n) {
+                auto bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < n; i++) {
+                        h ^= bytes[i];
+                        h *= 1099511628211ULL;
+                }
+        };
+        addBytes(pathData->elements.data(), pathData->elements.size() * sizeof(Element));
+        addBytes(pathData->values.data(), pathData->values.size() * sizeof(rk_real));
+        pathData->hash = h != 0 ? static_cast<size_t>(h) : 1;
+        return pathData->hash;
+}
+
+std::shared_ptr<RkPathData> RkPath::RkPathImpl::data() const
+{
+        return pathData;
+}
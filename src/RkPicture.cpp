@@ -0,0 +1,100 @@
+/**
+ * File name: RkPicture.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPicture.h"
+#include "RkPictureImpl.h"
+
+RkPicture::RkPicture()
+        : o_ptr{std::make_unique<RkPictureImpl>(this)}
+{
+}
+
+RkPicture::RkPicture(const RkPicture &picture)
+        : o_ptr{std::make_unique<RkPictureImpl>(this)}
+{
+        o_ptr->share(*picture.o_ptr);
+}
+
+RkPicture::RkPicture(RkPicture &&picture)
+        : o_ptr{std::make_unique<RkPictureImpl>(this)}
+{
+        o_ptr->take(*picture.o_ptr);
+}
+
+RkPicture::~RkPicture()
+{
+}
+
+RkPicture& RkPicture::operator=(const RkPicture &other)
+{
+        if (this != &other)
+                o_ptr->share(*other.o_ptr);
+        return *this;
+}
+
+RkPicture& RkPicture::operator=(RkPicture &&other)
+{
+        if (this != &other)
+                o_ptr->take(*other.o_ptr);
+        return *this;
+}
+
+bool operator==(const RkPicture &pic1, const RkPicture &pic2)
+{
+        return pic1.o_ptr->isEqual(*pic2.o_ptr);
+}
+
+bool operator!=(const RkPicture &pic1, const RkPicture &pic2)
+{
+        return !(pic1 == pic2);
+}
+
+const RkCanvasInfo* RkPicture::getCanvasInfo() const
+{
+        return nullptr;
+}
+
+void RkPicture::beginPaint()
+{
+        o_ptr->detach();
+}
+
+void RkPicture::clear()
+{
+        o_ptr->clear();
+}
+
+bool RkPicture::isEmpty() const
+{
+        return o_ptr->isEmpty();
+}
+
+size_t RkPicture::size() const
+{
+        return o_ptr->size();
+}
+
+size_t RkPicture::hash() const
+{
+        return o_ptr->hash();
+}
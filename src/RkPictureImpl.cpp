@@ -0,0 +1,553 @@
+/**
+ * File name: RkPictureImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPictureImpl.h"
+#include "RkCairoGraphicsBackend.h"
+
+#include <cstring>
+
+namespace {
+
+// FNV-1a
+uint64_t hashBytes(uint64_t hash, const void *data, size_t n)
+{
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+        }
+        return hash;
+}
+
+template<class T>
+uint64_t hashValue(uint64_t hash, const T &value)
+{
+        return hashBytes(hash, &value, sizeof(value));
+}
+
+} // namespace
+
+RkPicture::RkPictureImpl::RkPictureImpl(RkPicture *interface)
+        : inf_ptr{interface}
+        , pictureData{std::make_shared<RkPictureData>()}
+        , pictureHash{0}
+{
+        RK_UNUSED(inf_ptr);
+}
+
+RkPicture::RkPictureImpl::~RkPictureImpl()
+{
+}
+
+void RkPicture::RkPictureImpl::share(const RkPictureImpl &other)
+{
+        pictureData = other.pictureData;
+        pictureHash = other.pictureHash;
+}
+
+void RkPicture::RkPictureImpl::take(RkPictureImpl &other)
+{
+        pictureData = std::move(other.pictureData);
+        pictureHash = other.pictureHash;
+        other.pictureData = std::make_shared<RkPictureData>();
+        other.pictureHash = 0;
+}
+
+void RkPicture::RkPictureImpl::detach()
+{
+        if (pictureData.use_count() > 1)
+                pictureData = std::make_shared<RkPictureData>(*pictureData);
+}
+
+void RkPicture::RkPictureImpl::clear()
+{
+        pictureData = std::make_shared<RkPictureData>();
+        pictureHash = 0;
+}
+
+bool RkPicture::RkPictureImpl::isEmpty() const
+{
+        return pictureData->commands.empty();
+}
+
+size_t RkPicture::RkPictureImpl::size() const
+{
+        size_t n = pictureData->commands.size() * sizeof(int32_t);
+        for (const auto &str: pictureData->strings)
+                n += str.size();
+        for (const auto &picture: pictureData->pictures)
+                n += picture.size();
+        return n;
+}
+
+/**
+ * Images are hashed by size and format only, so the hash doesn't force
+ * lazily decoded images to decode. isEqual() compares them fully.
+ */
+size_t RkPicture::RkPictureImpl::hash() const
+{
+        if (pictureHash != 0)
+                return pictureHash;
+
+        uint64_t h = 14695981039346656037ULL;
+        const auto &data = *pictureData;
+        h = hashBytes(h, data.commands.data(), data.commands.size() * sizeof(int32_t));
+        for (const auto &str: data.strings)
+                h = hashBytes(h, str.data(), str.size());
+        for (const auto &image: data.images) {
+                h = hashValue(h, image.width());
+                h = hashValue(h, image.height());
+                h = hashValue(h, static_cast<int>(image.format()));
+        }
+        for (const auto &picture: data.pictures)
+                h = hashValue(h, picture.hash());
+        for (const auto &path: data.paths)
+                h = hashValue(h, path.hash());
+        pictureHash = h != 0 ? static_cast<size_t>(h) : 1;
+        return pictureHash;
+}
+
+bool RkPicture::RkPictureImpl::isEqual(const RkPictureImpl &other) const
+{
+        if (pictureData == other.pictureData)
+                return true;
+        if (hash() != other.hash())
+                return false;
+        const auto &data = *pictureData;
+        const auto &otherData = *other.pictureData;
+        return data.commands == otherData.commands
+                && data.strings == otherData.strings
+                && data.images == otherData.images
+                && data.pictures == otherData.pictures
+                && data.paths == otherData.paths;
+}
+
+RkPictureData& RkPicture::RkPictureImpl::record(Command command)
+{
+        detach();
+        pictureHash = 0;
+        pictureData->commands.push_back(static_cast<int32_t>(command));
+        return *pictureData;
+}
+
+int32_t RkPicture::RkPictureImpl::packColor(const RkColor &color)
+{
+        auto value = (static_cast<uint32_t>(color.red() & 0xff) << 24)
+                | (static_cast<uint32_t>(color.green() & 0xff) << 16)
+                | (static_cast<uint32_t>(color.blue() & 0xff) << 8)
+                | static_cast<uint32_t>(color.alpha() & 0xff);
+        return static_cast<int32_t>(value);
+}
+
+RkColor RkPicture::RkPictureImpl::unpackColor(int32_t value)
+{
+        auto v = static_cast<uint32_t>(value);
+        return RkColor((v >> 24) & 0xff, (v >> 16) & 0xff, (v >> 8) & 0xff, v & 0xff);
+}
+
+void RkPicture::RkPictureImpl::drawText(std::string_view text, int x, int y)
+{
+        auto &data = record(Command::Text);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.strings.size()), x, y});
+        data.strings.emplace_back(text);
+}
+
+void RkPicture::RkPictureImpl::drawImage(const RkImage &image, int x, int y)
+{
+        auto &data = record(Command::Image);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.images.size()), x, y});
+        data.images.push_back(image);
+}
+
+void RkPicture::RkPictureImpl::drawImage(const RkImage &image, const RkRect &source, int x, int y)
+{
+        auto &data = record(Command::ImageRect);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.images.size()),
+                                                   source.left(), source.top(),
+                                                   source.width(), source.height(),
+                                                   x, y});
+        data.images.push_back(image);
+}
+
+void RkPicture::RkPictureImpl::drawMask(const RkImage &mask, int x, int y, const RkColor &color)
+{
+        auto &data = record(Command::Mask);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.images.size()),
+                                                   x, y, packColor(color)});
+        data.images.push_back(mask);
+}
+
+void RkPicture::RkPictureImpl::drawEllipse(const RkPoint& p, int width, int height)
+{
+        auto &data = record(Command::Ellipse);
+        data.commands.insert(data.commands.end(), {p.x(), p.y(), width, height});
+}
+
+void RkPicture::RkPictureImpl::drawLine(const RkPoint &p1, const RkPoint &p2)
+{
+        auto &data = record(Command::Line);
+        data.commands.insert(data.commands.end(), {p1.x(), p1.y(), p2.x(), p2.y()});
+}
+
+void RkPicture::RkPictureImpl::drawRect(const RkRect &rect)
+{
+        auto &data = record(Command::Rect);
+        data.commands.insert(data.commands.end(), {rect.left(), rect.top(), rect.width(), rect.height()});
+}
+
+void RkPicture::RkPictureImpl::drawPolyline(const std::vector<RkPoint> &points)
+{
+        auto &data = record(Command::Polyline);
+        data.commands.push_back(static_cast<int32_t>(points.size()));
+        for (const auto &point: points)
+                data.commands.insert(data.commands.end(), {point.x(), point.y()});
+}
+
+void RkPicture::RkPictureImpl::drawPath(const RkPath &path)
+{
+        auto &data = record(Command::Path);
+        data.commands.push_back(static_cast<int32_t>(data.paths.size()));
+        data.paths.push_back(path);
+}
+
+void RkPicture::RkPictureImpl::fillPath(const RkPath &path, const RkColor &color)
+{
+        auto &data = record(Command::FillPath);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.paths.size()),
+                                                   packColor(color)});
+        data.paths.push_back(path);
+}
+
+void RkPicture::RkPictureImpl::fillRect(const RkRect &rect, const RkColor &color)
+{
+        auto &data = record(Command::FillRect);
+        data.commands.insert(data.commands.end(), {rect.left(), rect.top(),
+                                                   rect.width(), rect.height(),
+                                                   packColor(color)});
+}
+
+/**
+ * Batched items are recorded as the number of items followed by their
+ * coordinates, then the number of colors followed by the packed colors.
+ */
+void RkPicture::RkPictureImpl::recordPoints(Command command,
+                                            const std::vector<RkPoint> &points,
+                                            const std::vector<RkColor> &colors)
+{
+        auto &cmd = record(command).commands;
+        cmd.reserve(cmd.size() + 2 + 2 * points.size() + colors.size());
+        cmd.push_back(static_cast<int32_t>(points.size()));
+        for (const auto &point: points)
+                cmd.insert(cmd.end(), {point.x(), point.y()});
+        cmd.push_back(static_cast<int32_t>(colors.size()));
+        for (const auto &color: colors)
+                cmd.push_back(packColor(color));
+}
+
+void RkPicture::RkPictureImpl::recordRects(Command command,
+                                           const std::vector<RkRect> &rects,
+                                           const std::vector<RkColor> &colors)
+{
+        auto &cmd = record(command).commands;
+        cmd.reserve(cmd.size() + 2 + 4 * rects.size() + colors.size());
+        cmd.push_back(static_cast<int32_t>(rects.size()));
+        for (const auto &rect: rects)
+                cmd.insert(cmd.end(), {rect.left(), rect.top(), rect.width(), rect.height()});
+        cmd.push_back(static_cast<int32_t>(colors.size()));
+        for (const auto &color: colors)
+                cmd.push_back(packColor(color));
+}
+
+std::vector<RkPoint> RkPicture::RkPictureImpl::readPoints(const std::vector<int32_t> &cmd, size_t &i)
+{
+        std::vector<RkPoint> points(cmd[i++]);
+        for (auto &point: points) {
+                point = RkPoint(cmd[i], cmd[i + 1]);
+                i += 2;
+        }
+        return points;
+}
+
+std::vector<RkRect> RkPicture::RkPictureImpl::readRects(const std::vector<int32_t> &cmd, size_t &i)
+{
+        std::vector<RkRect> rects(cmd[i++]);
+        for (auto &rect: rects) {
+                rect = RkRect(cmd[i], cmd[i + 1], cmd[i + 2], cmd[i + 3]);
+                i += 4;
+        }
+        return rects;
+}
+
+std::vector<RkColor> RkPicture::RkPictureImpl::readColors(const std::vector<int32_t> &cmd, size_t &i)
+{
+        std::vector<RkColor> colors(cmd[i++]);
+        for (auto &color: colors)
+                color = unpackColor(cmd[i++]);
+        return colors;
+}
+
+void RkPicture::RkPictureImpl::drawLines(const std::vector<RkPoint> &points,
+                                         const std::vector<RkColor> &colors)
+{
+        recordPoints(Command::Lines, points, colors);
+}
+
+void RkPicture::RkPictureImpl::drawRects(const std::vector<RkRect> &rects,
+                                         const std::vector<RkColor> &colors)
+{
+        recordRects(Command::Rects, rects, colors);
+}
+
+void RkPicture::RkPictureImpl::fillRects(const std::vector<RkRect> &rects,
+                                         const std::vector<RkColor> &colors)
+{
+        recordRects(Command::FillRects, rects, colors);
+}
+
+void RkPicture::RkPictureImpl::drawPoints(const std::vector<RkPoint> &points,
+                                          const std::vector<RkColor> &colors)
+{
+        recordPoints(Command::Points, points, colors);
+}
+
+void RkPicture::RkPictureImpl::applyAlpha(int alpha)
+{
+        record(Command::Alpha).commands.push_back(alpha);
+}
+
+void RkPicture::RkPictureImpl::setPen(const RkPen &pen)
+{
+        auto &data = record(Command::Pen);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(pen.style()),
+                                                   pen.width(),
+                                                   packColor(pen.color())});
+}
+
+void RkPicture::RkPictureImpl::setFont(const RkFont &font)
+{
+        auto &data = record(Command::Font);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.strings.size()),
+                                                   font.size(),
+                                                   static_cast<int32_t>(font.weight()),
+                                                   static_cast<int32_t>(font.style())});
+        data.strings.push_back(font.family());
+}
+
+void RkPicture::RkPictureImpl::translate(const RkPoint &offset)
+{
+        auto &data = record(Command::Translate);
+        data.commands.insert(data.commands.end(), {offset.x(), offset.y()});
+}
+
+void RkPicture::RkPictureImpl::rotate(rk_real angle)
+{
+        auto value = static_cast<double>(angle);
+        int32_t words[2];
+        std::memcpy(words, &value, sizeof(words));
+        auto &data = record(Command::Rotate);
+        data.commands.insert(data.commands.end(), {words[0], words[1]});
+}
+
+void RkPicture::RkPictureImpl::drawPicture(const RkPicture &picture,
+                                           const RkRect &source,
+                                           int x,
+                                           int y)
+{
+        auto &data = record(Command::Picture);
+        data.commands.insert(data.commands.end(), {static_cast<int32_t>(data.pictures.size()),
+                                                   source.left(), source.top(),
+                                                   source.width(), source.height(),
+                                                   x, y});
+        data.pictures.push_back(picture);
+}
+
+void RkPicture::RkPictureImpl::save()
+{
+        record(Command::Save);
+}
+
+void RkPicture::RkPictureImpl::restore()
+{
+        record(Command::Restore);
+}
+
+void RkPicture::RkPictureImpl::clip(const std::vector<RkRect> &rects)
+{
+        recordRects(Command::Clip, rects, {});
+}
+
+void RkPicture::RkPictureImpl::replay(RkCairoGraphicsBackend *backend,
+                                      const RkRect &source,
+                                      int x,
+                                      int y) const
+{
+        // Keep a reference in case the picture is recorded into while replaying.
+        auto dataRef = pictureData;
+        const auto &data = *dataRef;
+        const auto &cmd = data.commands;
+        backend->save();
+        backend->translate(RkPoint(x - source.left(), y - source.top()));
+        if (source.area() > 0)
+                backend->clip({source});
+
+        // Unbalanced save and restore in the picture must not leak into the painter.
+        int savedStates = 0;
+        size_t i = 0;
+        while (i < cmd.size()) {
+                switch (static_cast<Command>(cmd[i++]))
+                {
+                case Command::Text:
+                        backend->drawText(data.strings[cmd[i]], cmd[i + 1], cmd[i + 2]);
+                        i += 3;
+                        break;
+                case Command::Image:
+                        backend->drawImage(data.images[cmd[i]], cmd[i + 1], cmd[i + 2]);
+                        i += 3;
+                        break;
+                case Command::ImageRect:
+                        backend->drawImage(data.images[cmd[i]],
+                                           RkRect(cmd[i + 1], cmd[i + 2], cmd[i + 3], cmd[i + 4]),
+                                           cmd[i + 5], cmd[i + 6]);
+                        i += 7;
+                        break;
+                case Command::Mask:
+                        backend->drawMask(data.images[cmd[i]], cmd[i + 1], cmd[i + 2],
+                                          unpackColor(cmd[i + 3]));
+                        i += 4;
+                        break;
+                case Command::Ellipse:
+                        backend->drawEllipse(RkPoint(cmd[i], cmd[i + 1]), cmd[i + 2], cmd[i + 3]);
+                        i += 4;
+                        break;
+                case Command::Line:
+                        backend->drawLine(RkPoint(cmd[i], cmd[i + 1]), RkPoint(cmd[i + 2], cmd[i + 3]));
+                        i += 4;
+                        break;
+                case Command::Rect:
+                        backend->drawRect(RkRect(cmd[i], cmd[i + 1], cmd[i + 2], cmd[i + 3]));
+                        i += 4;
+                        break;
+                case Command::Polyline:
+                        backend->drawPolyLine(readPoints(cmd, i));
+                        break;
+                case Command::FillRect:
+                        backend->fillRect(RkRect(cmd[i], cmd[i + 1], cmd[i + 2], cmd[i + 3]),
+                                          unpackColor(cmd[i + 4]));
+                        i += 5;
+                        break;
+                case Command::Alpha:
+                        backend->applyAlpha(cmd[i++]);
+                        break;
+                case Command::Pen:
+                {
+                        RkPen pen(unpackColor(cmd[i + 2]));
+                        pen.setStyle(static_cast<RkPen::PenStyle>(cmd[i]));
+                        pen.setWidth(cmd[i + 1]);
+                        backend->setPen(pen);
+                        i += 3;
+                        break;
+                }
+                case Command::Font:
+                        backend->setFont(RkFont(data.strings[cmd[i]], cmd[i + 1],
+                                                static_cast<RkFont::Weight>(cmd[i + 2]),
+                                                static_cast<RkFont::Style>(cmd[i + 3])));
+                        i += 4;
+                        break;
+                case Command::Translate:
+                        backend->translate(RkPoint(cmd[i], cmd[i + 1]));
+                        i += 2;
+                        break;
+                case Command::Rotate:
+                {
+                        double angle;
+                        std::memcpy(&angle, &cmd[i], sizeof(angle));
+                        backend->rotate(static_cast<rk_real>(angle));
+                        i += 2;
+                        break;
+                }
+                case Command::Picture:
+                        data.pictures[cmd[i]].o_ptr->replay(backend,
+                                                            RkRect(cmd[i + 1], cmd[i + 2],
+                                                                   cmd[i + 3], cmd[i + 4]),
+                                                            cmd[i + 5], cmd[i + 6]);
+                        i += 7;
+                        break;
+                case Command::Lines:
+                {
+                        auto points = readPoints(cmd, i);
+                        backend->drawLines(points, readColors(cmd, i));
+                        break;
+                }
+                case Command::Rects:
+                {
+                        auto rects = readRects(cmd, i);
+                        backend->drawRects(rects, readColors(cmd, i));
+                        break;
+                }
+                case Command::FillRects:
+                {
+                        auto rects = readRects(cmd, i);
+                        backend->fillRects(rects, readColors(cmd, i));
+                        break;
+                }
+                case Command::Points:
+                {
+                        auto points = readPoints(cmd, i);
+                        backend->drawPoints(points, readColors(cmd, i));
+                        break;
+                }
+                case Command::Path:
+                        backend->drawPath(data.paths[cmd[i++]]);
+                        break;
+                case Command::FillPath:
+                        backend->fillPath(data.paths[cmd[i]], unpackColor(cmd[i + 1]));
+                        i += 2;
+                        break;
+                case Command::Save:
+                        backend->save();
+                        savedStates++;
+                        break;
+                case Command::Restore:
+                        if (savedStates > 0) {
+                                backend->restore();
+                                savedStates--;
+                        }
+                        break;
+                case Command::Clip:
+                {
+                        auto rects = readRects(cmd, i);
+                        readColors(cmd, i);
+                        backend->clip(rects);
+                        break;
+                }
+                default:
+                        // Unknown command, the rest can't be decoded.
+                        i = cmd.size();
+                        break;
+                }
+        }
+
+        for (; savedStates > 0; savedStates--)
+                backend->restore();
+        backend->restore();
+}
@@ -0,0 +1,326 @@
+/**
+ * File name: RkPixelOps.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkPixelOps.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RK_PIXEL_OPS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Exact round(x / 255) for x <= 255 * 255.
+inline uint32_t div255(uint32_t x)
+{
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+}
+
+inline uint32_t multiplyPixel(uint32_t p, uint32_t alpha)
+{
+        return (div255(((p >> 24) & 0xff) * alpha) << 24)
+                | (div255(((p >> 16) & 0xff) * alpha) << 16)
+                | (div255(((p >> 8) & 0xff) * alpha) << 8)
+                | div255((p & 0xff) * alpha);
+}
+
+void fillScalar(uint32_t *dst, size_t n, uint32_t pixel)
+{
+        std::fill(dst, dst + n, pixel);
+}
+
+void applyAlphaScalar(uint32_t *pixels, size_t n, uint32_t alpha)
+{
+        for (size_t i = 0; i < n; i++)
+                pixels[i] = multiplyPixel(pixels[i], alpha);
+}
+
+#ifdef RK_PIXEL_OPS_X86
+__attribute__((target("sse2")))
+inline __m128i mulDiv255SSE2(__m128i x, __m128i a)
+{
+        auto t = _mm_add_epi16(_mm_mullo_epi16(x, a), _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("sse2")))
+void fillSSE2(uint32_t *dst, size_t n, uint32_t pixel)
+{
+        auto v = _mm_set1_epi32(static_cast<int>(pixel));
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+        fillScalar(dst + i, n - i, pixel);
+}
+
+__attribute__((target("sse2")))
+void applyAlphaSSE2(uint32_t *pixels, size_t n, uint32_t alpha)
+{
+        auto zero = _mm_setzero_si128();
+        auto a = _mm_set1_epi16(static_cast<short>(alpha));
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+                auto p = reinterpret_cast<__m128i*>(pixels + i);
+                auto v = _mm_loadu_si128(p);
+                auto lo = mulDiv255SSE2(_mm_unpacklo_epi8(v, zero), a);
+                auto hi = mulDiv255SSE2(_mm_unpackhi_epi8(v, zero), a);
+                _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+        }
+        applyAlphaScalar(pixels + i, n - i, alpha);
+}
+
+__attribute__((target("avx2")))
+inline __m256i mulDiv255AVX2(__m256i x, __m256i a)
+{
+        auto t = _mm256_add_epi16(_mm256_mullo_epi16(x, a), _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+void fillAVX2(uint32_t *dst, size_t n, uint32_t pixel)
+{
+        auto v = _mm256_set1_epi32(static_cast<int>(pixel));
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+        fillScalar(dst + i, n - i, pixel);
+}
+
+__attribute__((target("avx2")))
+void applyAlphaAVX2(uint32_t *pixels, size_t n, uint32_t alpha)
+{
+        auto zero = _mm256_setzero_si256();
+        auto a = _mm256_set1_epi16(static_cast<short>(alpha));
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+                auto p = reinterpret_cast<__m256i*>(pixels + i);
+                auto v = _mm256_loadu_si256(p);
+                auto lo = mulDiv255AVX2(_mm256_unpacklo_epi8(v, zero), a);
+                auto hi = mulDiv255AVX2(_mm256_unpackhi_epi8(v, zero), a);
+                _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+        }
+        applyAlphaScalar(pixels + i, n - i, alpha);
+}
+
+#endif // RK_PIXEL_OPS_X86
+
+RkPixelOps::Backend supportedBackend()
+{
+#ifdef RK_PIXEL_OPS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+                return RkPixelOps::Backend::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+                return RkPixelOps::Backend::SSE2;
+#endif
+        return RkPixelOps::Backend::Scalar;
+}
+
+// Contribution of the source pixels to one destination pixel, along one axis.
+struct RkResampleWeights {
+        int first = 0;
+        std::vector<float> weights;
+};
+
+std::vector<RkResampleWeights> resampleWeights(int srcLength, int dstLength)
+{
+        std::vector<RkResampleWeights> res(dstLength);
+        auto ratio = static_cast<double>(srcLength) / dstLength;
+        for (int d = 0; d < dstLength; d++) {
+                auto &w = res[d];
+                if (ratio >= 1.0) {
+                        auto x0 = d * ratio;
+                        auto x1 = std::min((d + 1) * ratio, static_cast<double>(srcLength));
+                        w.first = static_cast<int>(x0);
+                        for (int i = w.first; i < x1; i++)
+                                w.weights.push_back((std::min(i + 1.0, x1) - std::max(static_cast<double>(i), x0)) / ratio);
+                } else {
+                        auto center = std::clamp((d + 0.5) * ratio - 0.5, 0.0, srcLength - 1.0);
+                        w.first = std::min(static_cast<int>(center), srcLength - 1);
+                        auto frac = static_cast<float>(center - w.first);
+                        w.weights.push_back(1.0f - frac);
+                        if (w.first + 1 < srcLength)
+                                w.weights.push_back(frac);
+                }
+        }
+        return res;
+}
+
+std::atomic<RkPixelOps::Backend>& activeBackend()
+{
+        static std::atomic<RkPixelOps::Backend> backend{supportedBackend()};
+        return backend;
+}
+
+} // namespace
+
+RkPixelOps::Backend RkPixelOps::backend()
+{
+        return activeBackend().load(std::memory_order_relaxed);
+}
+
+void RkPixelOps::setBackend(Backend backend)
+{
+        auto supported = supportedBackend();
+        if (static_cast<int>(backend) > static_cast<int>(supported))
+                backend = supported;
+        activeBackend().store(backend, std::memory_order_relaxed);
+}
+
+uint32_t RkPixelOps::pixel(const RkColor &color)
+{
+        auto alpha = static_cast<uint32_t>(color.alpha()) & 0xff;
+        return (alpha << 24)
+                | (div255((static_cast<uint32_t>(color.red()) & 0xff) * alpha) << 16)
+                | (div255((static_cast<uint32_t>(color.green()) & 0xff) * alpha) << 8)
+                | div255((static_cast<uint32_t>(color.blue()) & 0xff) * alpha);
+}
+
+RkColor RkPixelOps::color(uint32_t pixel)
+{
+        auto alpha = pixel >> 24;
+        if (alpha == 0)
+                return RkColor(0, 0, 0, 0);
+        auto channel = [alpha](uint32_t c) {
+                return static_cast<int>(std::min<uint32_t>(255, (c * 255 + alpha / 2) / alpha));
+        };
+        return RkColor(channel((pixel >> 16) & 0xff), channel((pixel >> 8) & 0xff), channel(pixel & 0xff), alpha);
+}
+
+void RkPixelOps::fill(uint32_t *dst, size_t n, uint32_t pixel)
+{
+        switch (backend()) {
+#ifdef RK_PIXEL_OPS_X86
+        case Backend::AVX2: fillAVX2(dst, n, pixel); break;
+        case Backend::SSE2: fillSSE2(dst, n, pixel); break;
+#endif
+        default: fillScalar(dst, n, pixel);
+        }
+}
+
+void RkPixelOps::fillRect(unsigned char *data,
+                          int stride,
+                          int x,
+                          int y,
+                          int width,
+                          int height,
+                          uint32_t pixel)
+{
+        if (width < 1 || height < 1)
+                return;
+        for (int row = y; row < y + height; row++)
+                fill(reinterpret_cast<uint32_t*>(data + row * stride) + x, width, pixel);
+}
+
+void RkPixelOps::scroll(unsigned char *data,
+                        int stride,
+                        int width,
+                        int height,
+                        int pixelLength,
+                        int dx,
+                        int dy)
+{
+        if (std::abs(dx) >= width || std::abs(dy) >= height)
+                return;
+
+        auto rowLength = static_cast<size_t>(width - std::abs(dx)) * pixelLength;
+        auto srcX = std::max(-dx, 0) * pixelLength;
+        auto dstX = std::max(dx, 0) * pixelLength;
+        auto rows = height - std::abs(dy);
+        // Copy the rows in the direction that doesn't overwrite the source.
+        for (int i = 0; i < rows; i++) {
+                auto row = dy > 0 ? rows - 1 - i : i;
+                auto src = data + (row + std::max(-dy, 0)) * stride + srcX;
+                auto dst = data + (row + std::max(dy, 0)) * stride + dstX;
+                std::memmove(dst, src, rowLength);
+        }
+}
+
+void RkPixelOps::applyAlpha(uint32_t *pixels, size_t n, int alpha)
+{
+        auto a = static_cast<uint32_t>(std::clamp(alpha, 0, 255));
+        if (a == 255)
+                return;
+        switch (backend()) {
+#ifdef RK_PIXEL_OPS_X86
+        case Backend::AVX2: applyAlphaAVX2(pixels, n, a); break;
+        case Backend::SSE2: applyAlphaSSE2(pixels, n, a); break;
+#endif
+        default: applyAlphaScalar(pixels, n, a);
+        }
+}
+
+void RkPixelOps::resample(const unsigned char *src,
+                          int srcStride,
+                          int srcWidth,
+                          int srcHeight,
+                          unsigned char *dst,
+                          int dstStride,
+                          int dstWidth,
+                          int dstHeight,
+                          int channels)
+{
+        if (srcWidth < 1 || srcHeight < 1 || dstWidth < 1 || dstHeight < 1)
+                return;
+
+        auto columns = resampleWeights(srcWidth, dstWidth);
+        auto rows = resampleWeights(srcHeight, dstHeight);
+
+        // Horizontal pass into float rows, then vertical pass into the destination.
+        auto rowLength = static_cast<size_t>(dstWidth) * channels;
+        std::vector<float> tmp(rowLength * srcHeight, 0.0f);
+        for (int y = 0; y < srcHeight; y++) {
+                auto in = src + y * srcStride;
+                auto out = tmp.data() + y * rowLength;
+                for (int x = 0; x < dstWidth; x++) {
+                        const auto &w = columns[x];
+                        for (size_t i = 0; i < w.weights.size(); i++) {
+                                auto p = in + (w.first + i) * channels;
+                                for (int c = 0; c < channels; c++)
+                                        out[x * channels + c] += w.weights[i] * p[c];
+                        }
+                }
+        }
+
+        std::vector<float> acc(rowLength);
+        for (int y = 0; y < dstHeight; y++) {
+                const auto &w = rows[y];
+                std::fill(acc.begin(), acc.end(), 0.0f);
+                for (size_t i = 0; i < w.weights.size(); i++) {
+                        auto in = tmp.data() + (w.first + i) * rowLength;
+                        for (size_t j = 0; j < rowLength; j++)
+                                acc[j] += w.weights[i] * in[j];
+                }
+                auto out = dst + y * dstStride;
+                for (size_t j = 0; j < rowLength; j++)
+                        out[j] = static_cast<unsigned char>(std::clamp(std::lround(acc[j]), 0L, 255L));
+        }
+}
@@ -0,0 +1,153 @@
+/**
+ * File name: RkProxyModel.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkProxyModel.h"
+#include "RkProxyModelImpl.h"
+
+RkProxyModel::RkProxyModel(RkObject *parent, RkModel *source)
+        : RkModel(parent, std::make_unique<RkProxyModel::RkProxyModelImpl>(this, parent, source))
+        , impl_ptr{static_cast<RkProxyModel::RkProxyModelImpl*>(o_ptr.get())}
+{
+        if (!source)
+                return;
+
+        RK_ACT_BIND(source, modelChanged, RK_ACT_ARGS(), this, onSourceModelChanged());
+        RK_ACT_BIND(source, itemsInserted, RK_ACT_ARGS(size_t first, size_t last),
+                    this, onSourceItemsInserted(first, last));
+        RK_ACT_BIND(source, itemsRemoved, RK_ACT_ARGS(size_t first, size_t last),
+                    this, onSourceItemsRemoved(first, last));
+        RK_ACT_BIND(source, itemsChanged, RK_ACT_ARGS(size_t first, size_t last, int role),
+                    this, onSourceItemsChanged(first, last, role));
+}
+
+RkModel* RkProxyModel::sourceModel() const
+{
+        return impl_ptr->sourceModel();
+}
+
+void RkProxyModel::setFilter(const std::string &text)
+{
+        if (impl_ptr->setFilter(text))
+                action modelChanged();
+}
+
+std::string RkProxyModel::filter() const
+{
+        return impl_ptr->filter();
+}
+
+void RkProxyModel::setSortOrder(SortOrder order)
+{
+        if (impl_ptr->setSortOrder(order))
+                action modelChanged();
+}
+
+RkProxyModel::SortOrder RkProxyModel::sortOrder() const
+{
+        return impl_ptr->sortOrder();
+}
+
+size_t RkProxyModel::mapToSource(size_t index) const
+{
+        return impl_ptr->mapToSource(index);
+}
+
+size_t RkProxyModel::mapFromSource(size_t sourceIndex) const
+{
+        return impl_ptr->mapFromSource(sourceIndex);
+}
+
+RkVariant RkProxyModel::itemData(size_t index, int dataType) const
+{
+        auto sourceIndex = mapToSource(index);
+        if (sourceIndex == static_cast<size_t>(-1))
+                return RkVariant();
+        return sourceModel()->itemData(sourceIndex, dataType);
+}
+
+size_t RkProxyModel::itemsNumber() const
+{
+        return impl_ptr->itemsNumber();
+}
+
+int RkProxyModel::itemSpan() const
+{
+        return sourceModel() ? sourceModel()->itemSpan() : 0;
+}
+
+void RkProxyModel::itemsData(size_t first, size_t count, int dataTypes, RkModelRow *rows) const
+{
+        impl_ptr->itemsData(first, count, dataTypes, rows);
+}
+
+void RkProxyModel::itemsText(size_t first, size_t count, int dataType, RkModelRow *rows) const
+{
+        impl_ptr->itemsText(first, count, dataType, rows);
+}
+
+void RkProxyModel::onSourceModelChanged()
+{
+        impl_ptr->reset();
+        action modelChanged();
+}
+
+void RkProxyModel::onSourceItemsInserted(size_t first, size_t last)
+{
+        RkProxyModelImpl::Ranges ranges;
+        if (!impl_ptr->sourceItemsInserted(first, last, ranges)) {
+                action modelChanged();
+                return;
+        }
+
+        if (ranges.size() > 1)
+                beginUpdate();
+        for (const auto &range: ranges)
+                notifyItemsInserted(range.first, range.second);
+        if (ranges.size() > 1)
+                endUpdate();
+}
+
+void RkProxyModel::onSourceItemsRemoved(size_t first, size_t last)
+{
+        RkProxyModelImpl::Ranges ranges;
+        if (!impl_ptr->sourceItemsRemoved(first, last, ranges)) {
+                action modelChanged();
+                return;
+        }
+
+        if (ranges.size() > 1)
+                beginUpdate();
+        for (const auto &range: ranges)
+                notifyItemsRemoved(range.first, range.second);
+        if (ranges.size() > 1)
+                endUpdate();
+}
+
+void RkProxyModel::onSourceItemsChanged(size_t first, size_t last, int role)
+{
+        size_t proxyFirst, proxyLast;
+        if (!impl_ptr->sourceItemsChanged(first, last, role, proxyFirst, proxyLast))
+                action modelChanged();
+        else if (proxyFirst <= proxyLast)
+                notifyItemsChanged(proxyFirst, proxyLast, role);
+}
@@ -0,0 +1,394 @@
+/**
+ * File name: RkProxyModelImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkProxyModelImpl.h"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <thread>
+
+static constexpr size_t noIndex = static_cast<size_t>(-1);
+
+// The source data is fetched in chunks to reuse the rows buffer.
+static constexpr size_t fetchChunk = 4096;
+
+// Below this number of items sorting in threads doesn't pay off.
+static constexpr size_t parallelSortThreshold = 1 << 16;
+
+// Inserting more items than this maps all the items again.
+static constexpr size_t incrementalInsertLimit = 64;
+
+RkProxyModel::RkProxyModelImpl::RkProxyModelImpl(RkProxyModel* interface,
+                                                 RkObject* parent,
+                                                 RkModel *source)
+        : RkModelImpl(interface, parent)
+        , inf_ptr{interface}
+        , sourceItemsModel{source}
+        , itemsOrder{SortOrder::None}
+        , sortedRowsValid{false}
+        , sourceRowsValid{false}
+{
+        reset();
+}
+
+RkModel* RkProxyModel::RkProxyModelImpl::sourceModel() const
+{
+        return sourceItemsModel;
+}
+
+bool RkProxyModel::RkProxyModelImpl::setFilter(const std::string &text)
+{
+        std::string lowerText = text;
+        std::transform(lowerText.begin(), lowerText.end(), lowerText.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (lowerText == filterText)
+                return false;
+
+        // The items matching an extended filter are a subset of the current ones.
+        bool refine = lowerText.find(filterText) != std::string::npos;
+        filterText = std::move(lowerText);
+        if (refine) {
+                auto selected = mapToSource(selectedItem());
+                auto size = proxyRows.size();
+                proxyRows.erase(std::remove_if(proxyRows.begin(), proxyRows.end(),
+                                               [this](size_t row) { return !matches(row); }),
+                                proxyRows.end());
+                sourceRowsValid = false;
+                selectItem(mapFromSource(selected));
+                return proxyRows.size() != size;
+        }
+
+        mapRows();
+        return true;
+}
+
+const std::string& RkProxyModel::RkProxyModelImpl::filter() const
+{
+        return filterText;
+}
+
+bool RkProxyModel::RkProxyModelImpl::setSortOrder(SortOrder order)
+{
+        if (order == itemsOrder)
+                return false;
+        itemsOrder = order;
+        sortedRowsValid = false;
+        mapRows();
+        return true;
+}
+
+RkProxyModel::SortOrder RkProxyModel::RkProxyModelImpl::sortOrder() const
+{
+        return itemsOrder;
+}
+
+size_t RkProxyModel::RkProxyModelImpl::mapToSource(size_t index) const
+{
+        if (index >= proxyRows.size())
+                return noIndex;
+        return proxyRows[index];
+}
+
+size_t RkProxyModel::RkProxyModelImpl::mapFromSource(size_t sourceIndex) const
+{
+        if (sourceIndex >= sourceKeys.size())
+                return noIndex;
+
+        if (!sourceRowsValid) {
+                sourceRows.assign(sourceKeys.size(), noIndex);
+                for (size_t i = 0; i < proxyRows.size(); i++)
+                        sourceRows[proxyRows[i]] = i;
+                sourceRowsValid = true;
+        }
+        return sourceRows[sourceIndex];
+}
+
+size_t RkProxyModel::RkProxyModelImpl::itemsNumber() const
+{
+        return proxyRows.size();
+}
+
+template<class Fetch>
+void RkProxyModel::RkProxyModelImpl::fetchSourceRows(size_t first, size_t count, Fetch fetch) const
+{
+        if (first >= proxyRows.size())
+                return;
+
+        count = std::min(count, proxyRows.size() - first);
+        size_t i = 0;
+        while (i < count) {
+                // Fetch the consecutive source items with one call.
+                size_t n = 1;
+                while (i + n < count && proxyRows[first + i + n] == proxyRows[first + i] + n)
+                        n++;
+                fetch(proxyRows[first + i], n, i);
+                i += n;
+        }
+}
+
+void RkProxyModel::RkProxyModelImpl::itemsData(size_t first, size_t count,
+                                               int dataTypes, RkModelRow *rows) const
+{
+        fetchSourceRows(first, count, [&](size_t source, size_t n, size_t i) {
+                        sourceItemsModel->itemsData(source, n, dataTypes, rows + i);
+                });
+}
+
+void RkProxyModel::RkProxyModelImpl::itemsText(size_t first, size_t count,
+                                               int dataType, RkModelRow *rows) const
+{
+        fetchSourceRows(first, count, [&](size_t source, size_t n, size_t i) {
+                        sourceItemsModel->itemsText(source, n, dataType, rows + i);
+                });
+}
+
+void RkProxyModel::RkProxyModelImpl::reset()
+{
+        sourceKeys.clear();
+        if (sourceItemsModel) {
+                sourceKeys.resize(sourceItemsModel->itemsNumber());
+                loadKeys(0, sourceKeys.size());
+        }
+        sortedRowsValid = false;
+        mapRows();
+}
+
+bool RkProxyModel::RkProxyModelImpl::sourceItemsInserted(size_t first, size_t last, Ranges &inserted)
+{
+        if (first > sourceKeys.size())
+                first = sourceKeys.size();
+
+        auto count = last - first + 1;
+        sourceKeys.insert(sourceKeys.begin() + first, count, std::string());
+        loadKeys(first, first + count);
+        sortedRowsValid = false;
+        sourceRowsValid = false;
+        for (auto &row: proxyRows) {
+                if (row >= first)
+                        row += count;
+        }
+
+        if (count > incrementalInsertLimit) {
+                mapRows();
+                return false;
+        }
+
+        std::vector<size_t> positions;
+        for (auto row = first; row <= last; row++) {
+                if (!matches(row))
+                        continue;
+                std::vector<size_t>::iterator it;
+                if (itemsOrder == SortOrder::None)
+                        it = std::lower_bound(proxyRows.begin(), proxyRows.end(), row);
+                else
+                        it = std::upper_bound(proxyRows.begin(), proxyRows.end(), row,
+                                              [this](size_t a, size_t b) { return lessThan(a, b); });
+                auto position = static_cast<size_t>(it - proxyRows.begin());
+                proxyRows.insert(it, row);
+                for (auto &p: positions) {
+                        if (p >= position)
+                                p++;
+                }
+                positions.push_back(position);
+        }
+
+        // Ascending ranges, each valid after the previous ones were inserted.
+        std::sort(positions.begin(), positions.end());
+        inserted.clear();
+        for (auto position: positions) {
+                if (!inserted.empty() && inserted.back().second + 1 == position)
+                        inserted.back().second = position;
+                else
+                        inserted.emplace_back(position, position);
+        }
+        return true;
+}
+
+bool RkProxyModel::RkProxyModelImpl::sourceItemsRemoved(size_t first, size_t last, Ranges &removed)
+{
+        if (first >= sourceKeys.size())
+                return true;
+
+        last = std::min(last, sourceKeys.size() - 1);
+        auto count = last - first + 1;
+        sourceKeys.erase(sourceKeys.begin() + first, sourceKeys.begin() + last + 1);
+        sortedRowsValid = false;
+        sourceRowsValid = false;
+
+        std::vector<size_t> positions;
+        size_t n = 0;
+        for (size_t i = 0; i < proxyRows.size(); i++) {
+                auto row = proxyRows[i];
+                if (row >= first && row <= last) {
+                        positions.push_back(i);
+                        continue;
+                }
+                proxyRows[n++] = row > last ? row - count : row;
+        }
+        proxyRows.resize(n);
+
+        // Descending ranges, each valid after the previous ones were removed.
+        removed.clear();
+        for (auto it = positions.rbegin(); it != positions.rend(); ++it) {
+                if (!removed.empty() && removed.back().first == *it + 1)
+                        removed.back().first = *it;
+                else
+                        removed.emplace_back(*it, *it);
+        }
+        return true;
+}
+
+bool RkProxyModel::RkProxyModelImpl::sourceItemsChanged(size_t first, size_t last, int role,
+                                                        size_t &proxyFirst, size_t &proxyLast)
+{
+        proxyFirst = noIndex;
+        proxyLast = 0;
+        if (first >= sourceKeys.size())
+                return true;
+
+        last = std::min(last, sourceKeys.size() - 1);
+        if (role == -1 || role == static_cast<int>(RkModelItem::DataType::String)) {
+                loadKeys(first, last + 1);
+                sortedRowsValid = false;
+                if (!filterText.empty() || itemsOrder != SortOrder::None) {
+                        mapRows();
+                        return false;
+                }
+        }
+
+        for (auto row = first; row <= last; row++) {
+                auto index = mapFromSource(row);
+                if (index == noIndex)
+                        continue;
+                proxyFirst = std::min(proxyFirst, index);
+                proxyLast = std::max(proxyLast, index);
+        }
+        return true;
+}
+
+void RkProxyModel::RkProxyModelImpl::loadKeys(size_t first, size_t last)
+{
+        auto mask = RkModel::dataTypeMask(RkModelItem::DataType::String);
+        fetchRows.resize(std::min(fetchChunk, last - first));
+        for (auto chunk = first; chunk < last; chunk += fetchChunk) {
+                auto n = std::min(fetchChunk, last - chunk);
+                sourceItemsModel->itemsData(chunk, n, mask, fetchRows.data());
+                for (size_t i = 0; i < n; i++) {
+                        auto &key = sourceKeys[chunk + i];
+                        key.assign(fetchRows[i].text);
+                        std::transform(key.begin(), key.end(), key.begin(),
+                                       [](unsigned char c) { return std::tolower(c); });
+                }
+        }
+}
+
+bool RkProxyModel::RkProxyModelImpl::matches(size_t sourceIndex) const
+{
+        return filterText.empty() || sourceKeys[sourceIndex].find(filterText) != std::string::npos;
+}
+
+bool RkProxyModel::RkProxyModelImpl::lessThan(size_t a, size_t b) const
+{
+        // Equal items keep the source order.
+        int result = sourceKeys[a].compare(sourceKeys[b]);
+        if (itemsOrder == SortOrder::Descending)
+                result = -result;
+        return result < 0 || (result == 0 && a < b);
+}
+
+const std::vector<size_t>& RkProxyModel::RkProxyModelImpl::sortedSource()
+{
+        if (!sortedRowsValid) {
+                sortedRows.resize(sourceKeys.size());
+                std::iota(sortedRows.begin(), sortedRows.end(), 0);
+                if (itemsOrder != SortOrder::None)
+                        sortRows(sortedRows);
+                sortedRowsValid = true;
+        }
+        return sortedRows;
+}
+
+/**
+ * Big sources are sorted in chunks by several threads and the sorted
+ * chunks are merged in pairs, also in threads.
+ */
+void RkProxyModel::RkProxyModelImpl::sortRows(std::vector<size_t> &rows) const
+{
+        auto compare = [this](size_t a, size_t b) { return lessThan(a, b); };
+        auto threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+        if (rows.size() < parallelSortThreshold || threads < 2) {
+                std::sort(rows.begin(), rows.end(), compare);
+                return;
+        }
+
+        std::vector<size_t> bounds;
+        for (int i = 0; i <= threads; i++)
+                bounds.push_back(rows.size() * i / threads);
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i + 1 < bounds.size(); i++) {
+                workers.emplace_back([&rows, &bounds, &compare, i] {
+                                std::sort(rows.begin() + bounds[i], rows.begin() + bounds[i + 1], compare);
+                        });
+        }
+        for (auto &worker: workers)
+                worker.join();
+
+        while (bounds.size() > 2) {
+                workers.clear();
+                std::vector<size_t> merged;
+                size_t i = 0;
+                for (; i + 2 < bounds.size(); i += 2) {
+                        workers.emplace_back([&rows, &bounds, &compare, i] {
+                                        std::inplace_merge(rows.begin() + bounds[i],
+                                                           rows.begin() + bounds[i + 1],
+                                                           rows.begin() + bounds[i + 2],
+                                                           compare);
+                                });
+                        merged.push_back(bounds[i]);
+                }
+                for (; i < bounds.size(); i++)
+                        merged.push_back(bounds[i]);
+                for (auto &worker: workers)
+                        worker.join();
+                bounds = std::move(merged);
+        }
+}
+
+void RkProxyModel::RkProxyModelImpl::mapRows()
+{
+        auto selected = mapToSource(selectedItem());
+        proxyRows.clear();
+        const auto &rows = sortedSource();
+        if (filterText.empty()) {
+                proxyRows = rows;
+        } else {
+                for (auto row: rows) {
+                        if (matches(row))
+                                proxyRows.push_back(row);
+                }
+        }
+        sourceRowsValid = false;
+        selectItem(mapFromSource(selected));
+}
@@ -0,0 +1,134 @@
+/**
+ * File name: RkScrollArea.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkScrollArea.h"
+#include "RkScrollAreaImpl.h"
+#include "RkPainter.h"
+#include "RkEvent.h"
+
+RkScrollArea::RkScrollArea(RkWidget *parent)
+        : RkWidget(parent, std::make_unique<RkScrollArea::RkScrollAreaImpl>(this, parent))
+        , impl_ptr{static_cast<RkScrollArea::RkScrollAreaImpl*>(o_ptr.get())}
+{
+}
+
+void RkScrollArea::setContentSize(const RkSize &size)
+{
+        auto position = scrollPosition();
+        impl_ptr->setContentSize(size);
+        update();
+        if (scrollPosition() != position)
+                action scrollPositionChanged(scrollPosition());
+}
+
+const RkSize& RkScrollArea::contentSize() const
+{
+        return impl_ptr->contentSize();
+}
+
+void RkScrollArea::setScrollPosition(const RkPoint &position)
+{
+        if (impl_ptr->setScrollPosition(position)) {
+                update();
+                action scrollPositionChanged(scrollPosition());
+        }
+}
+
+const RkPoint& RkScrollArea::scrollPosition() const
+{
+        return impl_ptr->scrollPosition();
+}
+
+void RkScrollArea::scrollBy(int dx, int dy)
+{
+        setScrollPosition(RkPoint(scrollPosition().x() + dx, scrollPosition().y() + dy));
+}
+
+RkPoint RkScrollArea::maxScrollPosition() const
+{
+        return impl_ptr->maxScrollPosition();
+}
+
+void RkScrollArea::updateContent(const RkRect &rect)
+{
+        impl_ptr->invalidateContent(rect);
+        update();
+}
+
+void RkScrollArea::updateContent()
+{
+        impl_ptr->invalidateContent();
+        update();
+}
+
+void RkScrollArea::setTileSize(int size)
+{
+        impl_ptr->setTileSize(size);
+        update();
+}
+
+int RkScrollArea::tileSize() const
+{
+        return impl_ptr->tileSize();
+}
+
+void RkScrollArea::setTilesLimit(size_t limit)
+{
+        impl_ptr->setTilesLimit(limit);
+}
+
+size_t RkScrollArea::tilesLimit() const
+{
+        return impl_ptr->tilesLimit();
+}
+
+void RkScrollArea::paintContent(RkPainter &painter, const RkRect &rect)
+{
+}
+
+void RkScrollArea::paintEvent(RkPaintEvent *event)
+{
+        RkPainter painter(this);
+        impl_ptr->draw(painter);
+}
+
+void RkScrollArea::resizeEvent(RkResizeEvent *event)
+{
+        // A bigger view may be past the end of the content.
+        setScrollPosition(scrollPosition());
+}
+
+void RkScrollArea::mouseButtonPressEvent(RkMouseEvent *event)
+{
+        switch (event->button())
+        {
+        case RkMouseEvent::ButtonType::WheelUp:
+                scrollBy(0, -60);
+                break;
+        case RkMouseEvent::ButtonType::WheelDown:
+                scrollBy(0, 60);
+                break;
+        default:
+                break;
+        }
+}
@@ -0,0 +1,279 @@
+/**
+ * File name: RkScrollAreaImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkScrollAreaImpl.h"
+
+#include <algorithm>
+
+RkScrollArea::RkScrollAreaImpl::RkScrollAreaImpl(RkScrollArea *interface, RkWidget *parent)
+    : RkWidgetImpl(static_cast<RkWidget*>(interface), parent)
+    , inf_ptr{interface}
+    , areaContentSize{0, 0}
+    , areaScrollPosition{0, 0}
+    , areaTileSize{256}
+    , areaTilesLimit{256}
+    , paintCounter{0}
+    , viewValid{false}
+{
+}
+
+void RkScrollArea::RkScrollAreaImpl::setContentSize(const RkSize &size)
+{
+        if (size == areaContentSize)
+                return;
+        areaContentSize = size;
+        // The tiles at the edges have the content size.
+        invalidateContent();
+        auto max = maxScrollPosition();
+        areaScrollPosition = RkPoint(std::min(areaScrollPosition.x(), max.x()),
+                                     std::min(areaScrollPosition.y(), max.y()));
+}
+
+const RkSize& RkScrollArea::RkScrollAreaImpl::contentSize() const
+{
+        return areaContentSize;
+}
+
+/**
+ * Moves the pixels of the view and invalidates only the exposed strip.
+ * Scrolling more than the view size composes everything again.
+ */
+bool RkScrollArea::RkScrollAreaImpl::setScrollPosition(const RkPoint &position)
+{
+        auto max = maxScrollPosition();
+        RkPoint newPosition(std::clamp(position.x(), 0, max.x()), std::clamp(position.y(), 0, max.y()));
+        if (newPosition == areaScrollPosition)
+                return false;
+
+        auto dx = areaScrollPosition.x() - newPosition.x();
+        auto dy = areaScrollPosition.y() - newPosition.y();
+        areaScrollPosition = newPosition;
+        if (!viewValid)
+                return true;
+
+        auto size = viewImage.size();
+        if (std::abs(dx) >= size.width() || std::abs(dy) >= size.height()) {
+                viewValid = false;
+                return true;
+        }
+
+        viewImage.scroll(dx, dy);
+        if (viewDirtyRect.area() > 0) {
+                viewDirtyRect = RkRect(viewDirtyRect.left() + dx, viewDirtyRect.top() + dy,
+                                       viewDirtyRect.width(), viewDirtyRect.height());
+                viewDirtyRect = viewDirtyRect.intersected(RkRect(RkPoint(0, 0), size));
+        }
+        if (dy > 0)
+                invalidateView(RkRect(0, 0, size.width(), dy));
+        else if (dy < 0)
+                invalidateView(RkRect(0, size.height() + dy, size.width(), -dy));
+        if (dx > 0)
+                invalidateView(RkRect(0, 0, dx, size.height()));
+        else if (dx < 0)
+                invalidateView(RkRect(size.width() + dx, 0, -dx, size.height()));
+        return true;
+}
+
+const RkPoint& RkScrollArea::RkScrollAreaImpl::scrollPosition() const
+{
+        return areaScrollPosition;
+}
+
+RkPoint RkScrollArea::RkScrollAreaImpl::maxScrollPosition() const
+{
+        return RkPoint(std::max(areaContentSize.width() - inf_ptr->width(), 0),
+                       std::max(areaContentSize.height() - inf_ptr->height(), 0));
+}
+
+void RkScrollArea::RkScrollAreaImpl::invalidateContent(const RkRect &rect)
+{
+        auto area = rect.intersected(RkRect(RkPoint(0, 0), areaContentSize));
+        if (area.area() == 0)
+                return;
+
+        for (int row = area.top() / areaTileSize; row <= (area.bottom() - 1) / areaTileSize; row++) {
+                for (int column = area.left() / areaTileSize; column <= (area.right() - 1) / areaTileSize; column++) {
+                        auto res = contentTiles.find(tileKey(column, row));
+                        if (res == contentTiles.end())
+                                continue;
+                        auto &tile = res->second;
+                        // The size, the image is taken out of the cache while the tile is drawn.
+                        RkRect tileRect(RkPoint(column * areaTileSize, row * areaTileSize), tile.size);
+                        auto dirty = area.intersected(tileRect);
+                        dirty = RkRect(dirty.left() - tileRect.left(), dirty.top() - tileRect.top(),
+                                       dirty.width(), dirty.height());
+                        tile.dirtyRect = tile.dirtyRect.united(dirty);
+                }
+        }
+        invalidateView(RkRect(area.left() - areaScrollPosition.x(), area.top() - areaScrollPosition.y(),
+                              area.width(), area.height()));
+}
+
+void RkScrollArea::RkScrollAreaImpl::invalidateContent()
+{
+        contentTiles.clear();
+        viewValid = false;
+}
+
+void RkScrollArea::RkScrollAreaImpl::setTileSize(int size)
+{
+        size = std::max(size, 16);
+        if (size == areaTileSize)
+                return;
+        areaTileSize = size;
+        invalidateContent();
+}
+
+int RkScrollArea::RkScrollAreaImpl::tileSize() const
+{
+        return areaTileSize;
+}
+
+void RkScrollArea::RkScrollAreaImpl::setTilesLimit(size_t limit)
+{
+        areaTilesLimit = limit;
+        removeUnusedTiles();
+}
+
+size_t RkScrollArea::RkScrollAreaImpl::tilesLimit() const
+{
+        return areaTilesLimit;
+}
+
+/**
+ * Composes the invalidated part of the view from the tiles, drawing the
+ * missing and invalidated tiles, then copies the view to the widget.
+ */
+void RkScrollArea::RkScrollAreaImpl::draw(RkPainter &painter)
+{
+        auto size = inf_ptr->size();
+        if (size.width() < 1 || size.height() < 1)
+                return;
+
+        paintCounter++;
+        if (viewImage.size() != size) {
+                viewImage = RkImage(size);
+                viewValid = false;
+        }
+        if (!viewValid) {
+                viewDirtyRect = RkRect(RkPoint(0, 0), size);
+                viewValid = true;
+        }
+
+        if (viewDirtyRect.area() > 0) {
+                // The content invalidated while the tiles are drawn is composed on the next paint.
+                auto dirtyRect = viewDirtyRect;
+                viewDirtyRect = RkRect();
+                RkPainter viewPainter(&viewImage);
+                viewPainter.setClipRect(dirtyRect);
+                viewPainter.fillRect(dirtyRect, inf_ptr->background());
+                RkRect area(dirtyRect.left() + areaScrollPosition.x(),
+                            dirtyRect.top() + areaScrollPosition.y(),
+                            dirtyRect.width(),
+                            dirtyRect.height());
+                area = area.intersected(RkRect(RkPoint(0, 0), areaContentSize));
+                if (area.area() > 0) {
+                        for (int row = area.top() / areaTileSize; row <= (area.bottom() - 1) / areaTileSize; row++) {
+                                for (int column = area.left() / areaTileSize;
+                                     column <= (area.right() - 1) / areaTileSize;
+                                     column++) {
+                                        viewPainter.drawImage(tile(column, row),
+                                                              column * areaTileSize - areaScrollPosition.x(),
+                                                              row * areaTileSize - areaScrollPosition.y());
+                                }
+                        }
+                }
+        }
+        painter.drawImage(viewImage, 0, 0);
+        removeUnusedTiles();
+}
+
+uint64_t RkScrollArea::RkScrollAreaImpl::tileKey(int column, int row)
+{
+        return (static_cast<uint64_t>(row) << 32) | static_cast<uint32_t>(column);
+}
+
+/**
+ * Returns the image of the tile, drawing the invalidated part. The content
+ * may update itself while drawing, so the tile is drawn out of the cache.
+ */
+RkImage RkScrollArea::RkScrollAreaImpl::tile(int column, int row)
+{
+        auto key = tileKey(column, row);
+        auto &tile = contentTiles[key];
+        if (tile.image.isNull()) {
+                tile.image = RkImage(std::min(areaTileSize, areaContentSize.width() - column * areaTileSize),
+                                     std::min(areaTileSize, areaContentSize.height() - row * areaTileSize));
+                tile.size = tile.image.size();
+                tile.dirtyRect = RkRect(RkPoint(0, 0), tile.size);
+        }
+        tile.lastUse = paintCounter;
+        if (tile.dirtyRect.area() == 0)
+                return tile.image;
+
+        RkRect rect(tile.dirtyRect.left() + column * areaTileSize,
+                    tile.dirtyRect.top() + row * areaTileSize,
+                    tile.dirtyRect.width(),
+                    tile.dirtyRect.height());
+        auto clip = tile.dirtyRect;
+        tile.dirtyRect = RkRect();
+        RkImage image = std::move(tile.image);
+        {
+                RkPainter tilePainter(&image);
+                tilePainter.setClipRect(clip);
+                tilePainter.fillRect(clip, inf_ptr->background());
+                tilePainter.translate(RkPoint(-column * areaTileSize, -row * areaTileSize));
+                inf_ptr->paintContent(tilePainter, rect);
+        }
+
+        // The parts invalidated while drawing stay in the dirty rect of
+        // the tile, for the next paint.
+        auto res = contentTiles.find(key);
+        if (res != contentTiles.end() && res->second.image.isNull())
+                res->second.image = image;
+        return image;
+}
+
+void RkScrollArea::RkScrollAreaImpl::invalidateView(const RkRect &rect)
+{
+        if (!viewValid)
+                return;
+        viewDirtyRect = viewDirtyRect.united(rect.intersected(RkRect(RkPoint(0, 0), viewImage.size())));
+}
+
+void RkScrollArea::RkScrollAreaImpl::removeUnusedTiles()
+{
+        if (contentTiles.size() <= areaTilesLimit)
+                return;
+
+        // The tiles used in the last paint are kept.
+        std::vector<std::pair<uint64_t, uint64_t>> unused;
+        for (const auto &tile: contentTiles) {
+                if (tile.second.lastUse != paintCounter)
+                        unused.emplace_back(tile.second.lastUse, tile.first);
+        }
+        std::sort(unused.begin(), unused.end());
+        auto n = std::min(contentTiles.size() - areaTilesLimit, unused.size());
+        for (size_t i = 0; i < n; i++)
+                contentTiles.erase(unused[i].second);
+}
@@ -0,0 +1,231 @@
+/**
+ * File name: RkTableView.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkTableView.h"
+#include "RkTableViewImpl.h"
+#include "RkPainter.h"
+#include "RkEvent.h"
+
+RkTableView::RkTableView(RkWidget *parent, RkModel *model)
+        : RkWidget(parent, std::make_unique<RkTableView::RkTableViewImpl>(this, parent, model))
+        , impl_ptr{static_cast<RkTableView::RkTableViewImpl*>(o_ptr.get())}
+{
+        if (!model)
+                return;
+
+        RK_ACT_BIND(model, modelChanged, RK_ACT_ARGS(), this, onModelChanged());
+        RK_ACT_BIND(model, itemsChanged, RK_ACT_ARGS(size_t first, size_t last, int role),
+                    this, onItemsChanged(first, last));
+        RK_ACT_BIND(model, itemsInserted, RK_ACT_ARGS(size_t first, size_t last),
+                    this, onItemsInserted(first, last));
+        RK_ACT_BIND(model, itemsRemoved, RK_ACT_ARGS(size_t first, size_t last),
+                    this, onItemsRemoved(first, last));
+}
+
+void RkTableView::onModelChanged()
+{
+        auto offset = scrollOffset();
+        impl_ptr->invalidate();
+        impl_ptr->setScrollOffset(offset);
+        update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+void RkTableView::onItemsChanged(size_t first, size_t last)
+{
+        if (impl_ptr->itemsChanged(first, last))
+                update();
+}
+
+void RkTableView::onItemsInserted(size_t first, size_t last)
+{
+        auto offset = scrollOffset();
+        if (impl_ptr->itemsInserted(first, last))
+                update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+void RkTableView::onItemsRemoved(size_t first, size_t last)
+{
+        auto offset = scrollOffset();
+        if (impl_ptr->itemsRemoved(first, last))
+                update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+RkModel* RkTableView::getModel() const
+{
+        return impl_ptr->getModel();
+}
+
+size_t RkTableView::addColumn(const std::string &title, int width, int dataType)
+{
+        auto column = impl_ptr->addColumn(title, width, dataType);
+        update();
+        return column;
+}
+
+size_t RkTableView::columnsNumber() const
+{
+        return impl_ptr->columnsNumber();
+}
+
+std::string RkTableView::columnTitle(size_t column) const
+{
+        return impl_ptr->columnTitle(column);
+}
+
+void RkTableView::setColumnWidth(size_t column, int width)
+{
+        if (impl_ptr->setColumnWidth(column, width)) {
+                update();
+                action columnResized(column, columnWidth(column));
+        }
+}
+
+int RkTableView::columnWidth(size_t column) const
+{
+        return impl_ptr->columnWidth(column);
+}
+
+void RkTableView::setColumnResizable(size_t column, bool resizable)
+{
+        impl_ptr->setColumnResizable(column, resizable);
+}
+
+bool RkTableView::isColumnResizable(size_t column) const
+{
+        return impl_ptr->isColumnResizable(column);
+}
+
+void RkTableView::resizeColumnToContents(size_t column)
+{
+        setColumnWidth(column, impl_ptr->contentsWidth(column));
+}
+
+void RkTableView::setHeaderHeight(int height)
+{
+        if (impl_ptr->setHeaderHeight(height))
+                update();
+}
+
+int RkTableView::headerHeight() const
+{
+        return impl_ptr->headerHeight();
+}
+
+int RkTableView::scrollOffset() const
+{
+        return impl_ptr->scrollOffset();
+}
+
+void RkTableView::setScrollOffset(int offset)
+{
+        if (impl_ptr->setScrollOffset(offset)) {
+                update();
+                action scrollOffsetChanged(scrollOffset());
+        }
+}
+
+int RkTableView::maxScrollOffset() const
+{
+        return impl_ptr->maxScrollOffset();
+}
+
+int RkTableView::horizontalScrollOffset() const
+{
+        return impl_ptr->horizontalScrollOffset();
+}
+
+void RkTableView::setHorizontalScrollOffset(int offset)
+{
+        if (impl_ptr->setHorizontalScrollOffset(offset))
+                update();
+}
+
+int RkTableView::maxHorizontalScrollOffset() const
+{
+        return impl_ptr->maxHorizontalScrollOffset();
+}
+
+void RkTableView::scrollToItem(size_t index)
+{
+        setScrollOffset(impl_ptr->scrollOffsetForItem(index));
+}
+
+size_t RkTableView::itemAt(int y) const
+{
+        return impl_ptr->getIndex(y);
+}
+
+size_t RkTableView::columnAt(int x) const
+{
+        return impl_ptr->getColumn(x);
+}
+
+void RkTableView::paintEvent(RkPaintEvent *event)
+{
+        RkPainter painter(this);
+        impl_ptr->draw(painter);
+}
+
+void RkTableView::mouseMoveEvent(RkMouseEvent *event)
+{
+        int width;
+        if (impl_ptr->resize(event->x(), width))
+                setColumnWidth(impl_ptr->resizedColumn(), width);
+}
+
+void RkTableView::mouseButtonPressEvent(RkMouseEvent *event)
+{
+        auto span = getModel() ? getModel()->itemSpan() : 0;
+        switch (event->button())
+        {
+        case RkMouseEvent::ButtonType::Left:
+        {
+                auto column = impl_ptr->resizeHandleAt(event->x(), event->y());
+                if (column != static_cast<size_t>(-1))
+                        impl_ptr->startResize(column, event->x());
+                else if (getModel() && event->y() >= headerHeight())
+                        getModel()->selectItem(itemAt(event->y()));
+                break;
+        }
+        case RkMouseEvent::ButtonType::WheelUp:
+                setScrollOffset(scrollOffset() - 3 * span);
+                break;
+        case RkMouseEvent::ButtonType::WheelDown:
+                setScrollOffset(scrollOffset() + 3 * span);
+                break;
+        default:
+                break;
+        }
+}
+
+void RkTableView::mouseButtonReleaseEvent(RkMouseEvent *event)
+{
+        if (event->button() == RkMouseEvent::ButtonType::Left)
+                impl_ptr->stopResize();
+}
@@ -0,0 +1,532 @@
+/**
+ * File name: RkTableViewImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkTableViewImpl.h"
+
+#include <algorithm>
+#include <limits>
+
+static constexpr size_t noIndex = static_cast<size_t>(-1);
+static constexpr int minimumColumnWidth = 10;
+// Distance from the column edge where the mouse resizes the column.
+static constexpr int resizeHandleWidth = 3;
+// The text widths cache of a column is cleared when it grows above this.
+static constexpr size_t textWidthsLimit = 4096;
+
+RkTableView::RkTableViewImpl::RkTableViewImpl(RkTableView *interface,
+                                             RkWidget *parent,
+                                             RkModel *model)
+    : RkWidgetImpl(static_cast<RkWidget*>(interface), parent)
+    , inf_ptr{interface}
+    , tableModel{model}
+    , tableHeaderHeight{22}
+    , textMargin{5}
+    , verticalOffset{0}
+    , horizontalOffset{0}
+    , bodyValid{false}
+    , resizingColumn{noIndex}
+    , resizeStartX{0}
+    , resizeStartWidth{0}
+{
+}
+
+RkModel* RkTableView::RkTableViewImpl::getModel() const
+{
+        return tableModel;
+}
+
+size_t RkTableView::RkTableViewImpl::addColumn(const std::string &title, int width, int dataType)
+{
+        tableColumns.push_back({title, std::max(width, minimumColumnWidth), dataType, true, {}});
+        invalidate();
+        return tableColumns.size() - 1;
+}
+
+size_t RkTableView::RkTableViewImpl::columnsNumber() const
+{
+        return tableColumns.size();
+}
+
+std::string RkTableView::RkTableViewImpl::columnTitle(size_t column) const
+{
+        if (column >= tableColumns.size())
+                return std::string();
+        return tableColumns[column].title;
+}
+
+bool RkTableView::RkTableViewImpl::setColumnWidth(size_t column, int width)
+{
+        if (column >= tableColumns.size())
+                return false;
+
+        width = std::max(width, minimumColumnWidth);
+        if (tableColumns[column].width == width)
+                return false;
+        tableColumns[column].width = width;
+        horizontalOffset = std::clamp(horizontalOffset, 0, maxHorizontalScrollOffset());
+        invalidate();
+        return true;
+}
+
+int RkTableView::RkTableViewImpl::columnWidth(size_t column) const
+{
+        if (column >= tableColumns.size())
+                return 0;
+        return tableColumns[column].width;
+}
+
+void RkTableView::RkTableViewImpl::setColumnResizable(size_t column, bool resizable)
+{
+        if (column < tableColumns.size())
+                tableColumns[column].resizable = resizable;
+}
+
+bool RkTableView::RkTableViewImpl::isColumnResizable(size_t column) const
+{
+        return column < tableColumns.size() && tableColumns[column].resizable;
+}
+
+int RkTableView::RkTableViewImpl::contentsWidth(size_t column)
+{
+        if (column >= tableColumns.size())
+                return 0;
+
+        RkImage image(1, 1);
+        RkPainter painter(&image);
+        auto &tableColumn = tableColumns[column];
+        auto width = textWidth(painter, tableColumn, tableColumn.title);
+        auto visible = visibleItems();
+        if (visible.first < visible.second) {
+                visibleCells.resize(visible.second - visible.first);
+                tableModel->itemsText(visible.first, visibleCells.size(), tableColumn.dataType, visibleCells.data());
+                for (const auto &cell: visibleCells)
+                        width = std::max(width, textWidth(painter, tableColumn, cell.text));
+        }
+        return width + 2 * textMargin;
+}
+
+bool RkTableView::RkTableViewImpl::setHeaderHeight(int height)
+{
+        height = std::max(height, 0);
+        if (height == tableHeaderHeight)
+                return false;
+        tableHeaderHeight = height;
+        verticalOffset = std::clamp(verticalOffset, 0, maxScrollOffset());
+        invalidate();
+        return true;
+}
+
+int RkTableView::RkTableViewImpl::headerHeight() const
+{
+        return tableHeaderHeight;
+}
+
+int RkTableView::RkTableViewImpl::scrollOffset() const
+{
+        return verticalOffset;
+}
+
+bool RkTableView::RkTableViewImpl::setScrollOffset(int offset)
+{
+        offset = std::clamp(offset, 0, maxScrollOffset());
+        if (offset == verticalOffset)
+                return false;
+        scrollBody(0, verticalOffset - offset);
+        verticalOffset = offset;
+        return true;
+}
+
+int RkTableView::RkTableViewImpl::maxScrollOffset() const
+{
+        if (!tableModel)
+                return 0;
+        auto contentHeight = static_cast<long long>(tableModel->itemsNumber()) * tableModel->itemSpan();
+        auto offset = contentHeight - bodySize().height();
+        return static_cast<int>(std::clamp<long long>(offset, 0, std::numeric_limits<int>::max()));
+}
+
+int RkTableView::RkTableViewImpl::horizontalScrollOffset() const
+{
+        return horizontalOffset;
+}
+
+bool RkTableView::RkTableViewImpl::setHorizontalScrollOffset(int offset)
+{
+        offset = std::clamp(offset, 0, maxHorizontalScrollOffset());
+        if (offset == horizontalOffset)
+                return false;
+        scrollBody(horizontalOffset - offset, 0);
+        horizontalOffset = offset;
+        return true;
+}
+
+int RkTableView::RkTableViewImpl::maxHorizontalScrollOffset() const
+{
+        return std::max(tableWidth() - inf_ptr->width(), 0);
+}
+
+int RkTableView::RkTableViewImpl::scrollOffsetForItem(size_t index) const
+{
+        if (!tableModel || index >= tableModel->itemsNumber())
+                return verticalOffset;
+
+        auto span = tableModel->itemSpan();
+        auto height = bodySize().height();
+        auto top = static_cast<int>(index) * span;
+        if (top < verticalOffset)
+                return top;
+        if (top + span > verticalOffset + height)
+                return top + span - height;
+        return verticalOffset;
+}
+
+size_t RkTableView::RkTableViewImpl::getIndex(int y) const
+{
+        if (!tableModel || tableModel->itemSpan() < 1 || y < tableHeaderHeight)
+                return noIndex;
+
+        auto index = static_cast<size_t>((y - tableHeaderHeight + verticalOffset) / tableModel->itemSpan());
+        if (index >= tableModel->itemsNumber())
+                return noIndex;
+        return index;
+}
+
+size_t RkTableView::RkTableViewImpl::getColumn(int x) const
+{
+        auto pos = x + horizontalOffset;
+        if (pos < 0)
+                return noIndex;
+        for (size_t i = 0; i < tableColumns.size(); i++) {
+                if (pos < tableColumns[i].width)
+                        return i;
+                pos -= tableColumns[i].width;
+        }
+        return noIndex;
+}
+
+size_t RkTableView::RkTableViewImpl::resizeHandleAt(int x, int y) const
+{
+        if (y < 0 || y >= tableHeaderHeight)
+                return noIndex;
+
+        auto edge = -horizontalOffset;
+        for (size_t i = 0; i < tableColumns.size(); i++) {
+                edge += tableColumns[i].width;
+                if (tableColumns[i].resizable && std::abs(x - edge) <= resizeHandleWidth)
+                        return i;
+        }
+        return noIndex;
+}
+
+void RkTableView::RkTableViewImpl::startResize(size_t column, int x)
+{
+        if (column >= tableColumns.size())
+                return;
+        resizingColumn = column;
+        resizeStartX = x;
+        resizeStartWidth = tableColumns[column].width;
+}
+
+bool RkTableView::RkTableViewImpl::isResizing() const
+{
+        return resizingColumn != noIndex;
+}
+
+bool RkTableView::RkTableViewImpl::resize(int x, int &width)
+{
+        if (!isResizing())
+                return false;
+        width = resizeStartWidth + x - resizeStartX;
+        return true;
+}
+
+size_t RkTableView::RkTableViewImpl::resizedColumn() const
+{
+        return resizingColumn;
+}
+
+void RkTableView::RkTableViewImpl::stopResize()
+{
+        resizingColumn = noIndex;
+}
+
+/**
+ * Draws the parts of the rows buffer that were invalidated, then the
+ * buffer and the header on the widget.
+ */
+void RkTableView::RkTableViewImpl::draw(RkPainter &painter)
+{
+        auto size = bodySize();
+        if (size.width() > 0 && size.height() > 0) {
+                if (bodyImage.size() != size) {
+                        bodyImage = RkImage(size);
+                        bodyValid = false;
+                }
+                if (!bodyValid) {
+                        dirtyRect = RkRect(RkPoint(0, 0), size);
+                        bodyValid = true;
+                }
+                if (dirtyRect.area() > 0) {
+                        RkPainter bodyPainter(&bodyImage);
+                        bodyPainter.setClipRect(dirtyRect);
+                        bodyPainter.fillRect(dirtyRect, inf_ptr->background());
+                        drawCells(bodyPainter, dirtyRect);
+                        dirtyRect = RkRect();
+                }
+                painter.drawImage(bodyImage, 0, tableHeaderHeight);
+        }
+        drawHeader(painter);
+}
+
+void RkTableView::RkTableViewImpl::invalidate()
+{
+        bodyValid = false;
+        dirtyRect = RkRect();
+}
+
+bool RkTableView::RkTableViewImpl::itemsChanged(size_t first, size_t last)
+{
+        auto visible = visibleItems();
+        if (first >= visible.second || last < visible.first)
+                return false;
+
+        auto span = tableModel->itemSpan();
+        auto top = static_cast<int>(std::max(first, visible.first)) * span - verticalOffset;
+        auto bottom = static_cast<int>(std::min(last + 1, visible.second)) * span - verticalOffset;
+        invalidate(RkRect(0, top, bodySize().width(), bottom - top));
+        return true;
+}
+
+/**
+ * Items inserted above the visible ones move the scroll offset with them,
+ * so the visible rows and the buffer stay as they are.
+ */
+bool RkTableView::RkTableViewImpl::itemsInserted(size_t first, size_t last)
+{
+        auto visible = visibleItems();
+        auto count = static_cast<int>(last - first + 1);
+        if (first < visible.first) {
+                verticalOffset = std::min(verticalOffset + count * tableModel->itemSpan(), maxScrollOffset());
+                return false;
+        }
+        if (first < visible.second || visible.first == visible.second) {
+                invalidate();
+                return true;
+        }
+        return false;
+}
+
+bool RkTableView::RkTableViewImpl::itemsRemoved(size_t first, size_t last)
+{
+        auto visible = visibleItems();
+        auto span = tableModel->itemSpan();
+        if (last < visible.first) {
+                auto offset = verticalOffset - static_cast<int>(last - first + 1) * span;
+                verticalOffset = std::clamp(offset, 0, maxScrollOffset());
+                if (verticalOffset == offset)
+                        return false;
+        } else {
+                if (first < visible.first)
+                        verticalOffset = static_cast<int>(first) * span;
+                verticalOffset = std::clamp(verticalOffset, 0, maxScrollOffset());
+        }
+        invalidate();
+        return true;
+}
+
+RkSize RkTableView::RkTableViewImpl::bodySize() const
+{
+        return RkSize(inf_ptr->width(), std::max(inf_ptr->height() - tableHeaderHeight, 0));
+}
+
+int RkTableView::RkTableViewImpl::tableWidth() const
+{
+        int width = 0;
+        for (const auto &column: tableColumns)
+                width += column.width;
+        return width;
+}
+
+std::pair<size_t, size_t> RkTableView::RkTableViewImpl::visibleItems() const
+{
+        if (!tableModel || tableModel->itemSpan() < 1)
+                return {0, 0};
+
+        auto span = tableModel->itemSpan();
+        auto first = static_cast<size_t>(verticalOffset / span);
+        auto last = std::min(static_cast<size_t>((verticalOffset + bodySize().height() + span - 1) / span),
+                             tableModel->itemsNumber());
+        return {first, std::max(first, last)};
+}
+
+/**
+ * Moves the drawn rows in the buffer and invalidates only the exposed
+ * strip. Scrolling more than the buffer size draws everything again.
+ */
+void RkTableView::RkTableViewImpl::scrollBody(int dx, int dy)
+{
+        if (!bodyValid)
+                return;
+
+        auto size = bodyImage.size();
+        if (std::abs(dx) >= size.width() || std::abs(dy) >= size.height()) {
+                invalidate();
+                return;
+        }
+
+        bodyImage.scroll(dx, dy);
+        if (dirtyRect.area() > 0) {
+                dirtyRect = RkRect(dirtyRect.left() + dx, dirtyRect.top() + dy,
+                                   dirtyRect.width(), dirtyRect.height());
+                dirtyRect = dirtyRect.intersected(RkRect(RkPoint(0, 0), size));
+        }
+        if (dy > 0)
+                invalidate(RkRect(0, 0, size.width(), dy));
+        else if (dy < 0)
+                invalidate(RkRect(0, size.height() + dy, size.width(), -dy));
+        if (dx > 0)
+                invalidate(RkRect(0, 0, dx, size.height()));
+        else if (dx < 0)
+                invalidate(RkRect(size.width() + dx, 0, -dx, size.height()));
+}
+
+void RkTableView::RkTableViewImpl::invalidate(const RkRect &rect)
+{
+        if (!bodyValid)
+                return;
+        dirtyRect = dirtyRect.united(rect.intersected(RkRect(RkPoint(0, 0), bodySize())));
+}
+
+/**
+ * Draws the cells that intersect the area, in buffer coordinates. The
+ * text is clipped only when its cached width doesn't fit the cell.
+ */
+void RkTableView::RkTableViewImpl::drawCells(RkPainter &painter, const RkRect &area)
+{
+        if (!tableModel || tableModel->itemSpan() < 1 || tableColumns.empty())
+                return;
+
+        auto span = tableModel->itemSpan();
+        auto first = static_cast<size_t>(std::max(area.top() + verticalOffset, 0) / span);
+        auto last = std::min(static_cast<size_t>((area.bottom() + verticalOffset + span - 1) / span),
+                             tableModel->itemsNumber());
+        if (first >= last)
+                return;
+
+        size_t firstColumn = 0;
+        int firstX = -horizontalOffset;
+        while (firstColumn < tableColumns.size() && firstX + tableColumns[firstColumn].width <= area.left())
+                firstX += tableColumns[firstColumn++].width;
+        auto lastColumn = firstColumn;
+        for (int x = firstX; lastColumn < tableColumns.size() && x < area.right(); lastColumn++)
+                x += tableColumns[lastColumn].width;
+
+        // One call per strip for the row colors and for the text of each column.
+        auto rowsNumber = last - first;
+        visibleRows.resize(rowsNumber);
+        tableModel->itemsData(first, rowsNumber,
+                              RkModel::dataTypeMask(RkModelItem::DataType::Color),
+                              visibleRows.data());
+        visibleCells.resize(rowsNumber * (lastColumn - firstColumn));
+        for (auto column = firstColumn; column < lastColumn; column++)
+                tableModel->itemsText(first, rowsNumber, tableColumns[column].dataType,
+                                      visibleCells.data() + (column - firstColumn) * rowsNumber);
+
+        const RkPen defaultPen = painter.pen();
+        for (auto row = first; row < last; row++) {
+                RkPen pen = defaultPen;
+                if (visibleRows[row - first].hasColor)
+                        pen.setColor(visibleRows[row - first].color);
+                if (tableModel->isItemSelected(row))
+                        pen.setColor({255, 255, 255});
+                painter.setPen(pen);
+
+                int y = static_cast<int>(row) * span - verticalOffset;
+                int x = firstX;
+                for (auto column = firstColumn; column < lastColumn; column++) {
+                        auto &tableColumn = tableColumns[column];
+                        auto text = visibleCells[(column - firstColumn) * rowsNumber + row - first].text;
+                        if (!text.empty()) {
+                                RkRect textRect(x + textMargin, y, tableColumn.width - 2 * textMargin, span);
+                                if (textWidth(painter, tableColumn, text) <= textRect.width()) {
+                                        painter.drawText(textRect, text, Rk::Alignment::AlignLeft);
+                                } else {
+                                        painter.save();
+                                        painter.setClipRect(RkRect(x, y, tableColumn.width, span));
+                                        painter.drawText(textRect, text, Rk::Alignment::AlignLeft);
+                                        painter.restore();
+                                }
+                        }
+                        x += tableColumn.width;
+                }
+        }
+        painter.setPen(defaultPen);
+}
+
+void RkTableView::RkTableViewImpl::drawHeader(RkPainter &painter)
+{
+        auto width = inf_ptr->width();
+        if (tableHeaderHeight < 1 || width < 1)
+                return;
+
+        const auto &background = inf_ptr->background();
+        RkColor headerColor(std::max(background.red() - 20, 0),
+                            std::max(background.green() - 20, 0),
+                            std::max(background.blue() - 20, 0));
+        painter.fillRect(RkRect(0, 0, width, tableHeaderHeight), headerColor);
+        painter.save();
+        painter.setClipRect(RkRect(0, 0, width, tableHeaderHeight));
+        int x = -horizontalOffset;
+        for (auto &column: tableColumns) {
+                if (x >= width)
+                        break;
+                if (x + column.width > 0) {
+                        RkRect textRect(x + textMargin, 0, column.width - 2 * textMargin, tableHeaderHeight);
+                        if (textWidth(painter, column, column.title) <= textRect.width()) {
+                                painter.drawText(textRect, column.title, Rk::Alignment::AlignLeft);
+                        } else {
+                                painter.save();
+                                painter.setClipRect(RkRect(x, 0, column.width, tableHeaderHeight));
+                                painter.drawText(textRect, column.title, Rk::Alignment::AlignLeft);
+                                painter.restore();
+                        }
+                        painter.drawLine(x + column.width - 1, 2, x + column.width - 1, tableHeaderHeight - 3);
+                }
+                x += column.width;
+        }
+        painter.drawLine(0, tableHeaderHeight - 1, width, tableHeaderHeight - 1);
+        painter.restore();
+}
+
+int RkTableView::RkTableViewImpl::textWidth(RkPainter &painter, Column &column, std::string_view text)
+{
+        auto it = column.textWidths.find(text);
+        if (it != column.textWidths.end())
+                return it->second;
+
+        if (column.textWidths.size() >= textWidthsLimit)
+                column.textWidths.clear();
+        auto width = painter.getTextWidth(text);
+        column.textWidths.emplace(std::string(text), width);
+        return width;
+}
@@ -0,0 +1,200 @@
+/**
+ * File name: RkTreeModel.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkTreeModel.h"
+#include "RkTreeModelImpl.h"
+#include "RkEventQueue.h"
+#include "RkAction.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+struct RkTreeFetch {
+        std::shared_ptr<RkTreeFetchState> state;
+        RkEventQueue *queue;
+        RkTreeModel *model;
+        std::function<void()> load;
+        std::function<void()> finish;
+};
+
+/**
+ * The few threads shared by the fetches of all the models. The pending
+ * fetches of a model are dropped when it is deleted, the threads are
+ * joined at exit.
+ */
+class RkTreeFetchPool {
+ public:
+        static RkTreeFetchPool& instance()
+        {
+                static RkTreeFetchPool pool;
+                return pool;
+        }
+
+        ~RkTreeFetchPool()
+        {
+                {
+                        std::lock_guard<std::mutex> lock(poolMutex);
+                        stopWorkers = true;
+                        pendingFetches.clear();
+                }
+                poolCondition.notify_all();
+                for (auto &worker: workers)
+                        worker.join();
+        }
+
+        void submit(RkTreeFetch fetch)
+        {
+                {
+                        std::lock_guard<std::mutex> lock(poolMutex);
+                        if (workers.empty()) {
+                                for (int i = 0; i < threadsNumber; i++)
+                                        workers.emplace_back(&RkTreeFetchPool::run, this);
+                        }
+                        pendingFetches.push_back(std::move(fetch));
+                }
+                poolCondition.notify_one();
+        }
+
+        void remove(const std::shared_ptr<RkTreeFetchState> &state)
+        {
+                std::lock_guard<std::mutex> lock(poolMutex);
+                pendingFetches.erase(std::remove_if(pendingFetches.begin(),
+                                                    pendingFetches.end(),
+                                                    [&state](const RkTreeFetch &fetch) {
+                                                            return fetch.state == state;
+                                                    }),
+                                     pendingFetches.end());
+        }
+
+ private:
+        RkTreeFetchPool()
+                : stopWorkers{false}
+        {
+                auto n = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+                threadsNumber = std::clamp(n, 1, 2);
+        }
+
+        void run()
+        {
+                for (;;) {
+                        RkTreeFetch fetch;
+                        {
+                                std::unique_lock<std::mutex> lock(poolMutex);
+                                poolCondition.wait(lock, [this] {
+                                                return stopWorkers || !pendingFetches.empty();
+                                        });
+                                if (stopWorkers)
+                                        return;
+                                fetch = std::move(pendingFetches.front());
+                                pendingFetches.pop_front();
+                        }
+                        load(fetch);
+                }
+        }
+
+        void load(const RkTreeFetch &fetch)
+        {
+                {
+                        std::lock_guard<std::mutex> lock(fetch.state->fetchMutex);
+                        if (fetch.state->cancelled)
+                                return;
+                }
+
+                fetch.load();
+
+                // The model cancels under the same lock before it is deleted.
+                std::lock_guard<std::mutex> lock(fetch.state->fetchMutex);
+                if (fetch.state->cancelled)
+                        return;
+                auto act = std::make_unique<RkAction>(fetch.model);
+                act->setCallback(fetch.finish);
+                fetch.queue->postAction(std::move(act));
+        }
+
+        std::mutex poolMutex;
+        std::condition_variable poolCondition;
+        std::deque<RkTreeFetch> pendingFetches;
+        std::vector<std::thread> workers;
+        bool stopWorkers;
+        int threadsNumber;
+};
+
+RkTreeModel::RkTreeModel(RkObject *parent)
+        : RkObject(parent, std::make_unique<RkTreeModel::RkTreeModelImpl>(this, parent))
+        , impl_ptr{static_cast<RkTreeModel::RkTreeModelImpl*>(o_ptr.get())}
+{
+}
+
+RkTreeModel::~RkTreeModel()
+{
+        // Before RkObject removes the posted actions of the model.
+        impl_ptr->cancelFetches();
+        RkTreeFetchPool::instance().remove(impl_ptr->fetchState());
+}
+
+bool RkTreeModel::hasChildren(NodeId node) const
+{
+        return childrenNumber(node) > 0 || canFetchMore(node);
+}
+
+bool RkTreeModel::canFetchMore(NodeId parent) const
+{
+        return false;
+}
+
+void RkTreeModel::fetchMore(NodeId parent)
+{
+}
+
+void RkTreeModel::notifyChildrenInserted(NodeId parent, size_t first, size_t last)
+{
+        if (first <= last)
+                action childrenInserted(parent, first, last);
+}
+
+void RkTreeModel::notifyChildrenRemoved(NodeId parent, size_t first, size_t last)
+{
+        if (first <= last)
+                action childrenRemoved(parent, first, last);
+}
+
+void RkTreeModel::notifyNodeChanged(NodeId node)
+{
+        action nodeChanged(node);
+}
+
+void RkTreeModel::fetchAsync(std::function<void()> load, std::function<void()> finish)
+{
+        auto queue = eventQueue();
+        if (!queue) {
+                load();
+                finish();
+                return;
+        }
+
+        RkTreeFetchPool::instance().submit({impl_ptr->fetchState(), queue, this,
+                                            std::move(load), std::move(finish)});
+}
@@ -0,0 +1,43 @@
+/**
+ * File name: RkTreeModelImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkTreeModelImpl.h"
+
+RkTreeModel::RkTreeModelImpl::RkTreeModelImpl(RkTreeModel* interface, RkObject* parent)
+        : RkObjectImpl(interface, parent)
+        , inf_ptr{interface}
+        , treeFetchState{std::make_shared<RkTreeFetchState>()}
+{
+}
+
+const std::shared_ptr<RkTreeFetchState>& RkTreeModel::RkTreeModelImpl::fetchState() const
+{
+        return treeFetchState;
+}
+
+void RkTreeModel::RkTreeModelImpl::cancelFetches()
+{
+        // The running fetches may still post their results until this returns.
+        std::lock_guard<std::mutex> lock(treeFetchState->fetchMutex);
+        treeFetchState->cancelled = true;
+}
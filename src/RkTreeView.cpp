@@ -0,0 +1,220 @@
+/**
+ * File name: RkTreeView.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkTreeView.h"
+#include "RkTreeViewImpl.h"
+#include "RkPainter.h"
+#include "RkEvent.h"
+
+RkTreeView::RkTreeView(RkWidget *parent, RkTreeModel *model)
+        : RkWidget(parent, std::make_unique<RkTreeView::RkTreeViewImpl>(this, parent, model))
+        , impl_ptr{static_cast<RkTreeView::RkTreeViewImpl*>(o_ptr.get())}
+{
+        if (!model)
+                return;
+
+        impl_ptr->reset();
+
+        RK_ACT_BIND(model, modelChanged, RK_ACT_ARGS(), this, onModelChanged());
+        RK_ACT_BIND(model, childrenInserted, RK_ACT_ARGS(NodeId parent, size_t first, size_t last),
+                    this, onChildrenInserted(parent, first, last));
+        RK_ACT_BIND(model, childrenRemoved, RK_ACT_ARGS(NodeId parent, size_t first, size_t last),
+                    this, onChildrenRemoved(parent, first, last));
+        RK_ACT_BIND(model, nodeChanged, RK_ACT_ARGS(NodeId node), this, onNodeChanged(node));
+}
+
+void RkTreeView::onModelChanged()
+{
+        auto offset = scrollOffset();
+        impl_ptr->reset();
+        update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+void RkTreeView::onChildrenInserted(NodeId parent, size_t first, size_t last)
+{
+        auto offset = scrollOffset();
+        if (impl_ptr->childrenInserted(parent, first, last))
+                update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+void RkTreeView::onChildrenRemoved(NodeId parent, size_t first, size_t last)
+{
+        auto offset = scrollOffset();
+        if (impl_ptr->childrenRemoved(parent, first, last))
+                update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+}
+
+void RkTreeView::onNodeChanged(NodeId node)
+{
+        if (impl_ptr->nodeChanged(node))
+                update();
+}
+
+RkTreeModel* RkTreeView::getModel() const
+{
+        return impl_ptr->getModel();
+}
+
+void RkTreeView::expand(NodeId node)
+{
+        auto offset = scrollOffset();
+        if (!impl_ptr->expand(node))
+                return;
+
+        update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+        action nodeExpanded(node);
+        // The fetched children are added when the model notifies them.
+        if (getModel()->canFetchMore(node))
+                getModel()->fetchMore(node);
+}
+
+void RkTreeView::collapse(NodeId node)
+{
+        auto offset = scrollOffset();
+        if (!impl_ptr->collapse(node))
+                return;
+
+        update();
+        if (scrollOffset() != offset)
+                action scrollOffsetChanged(scrollOffset());
+        action nodeCollapsed(node);
+}
+
+bool RkTreeView::isExpanded(NodeId node) const
+{
+        return impl_ptr->isExpanded(node);
+}
+
+void RkTreeView::setIndentation(int indentation)
+{
+        impl_ptr->setIndentation(indentation);
+        update();
+}
+
+int RkTreeView::indentation() const
+{
+        return impl_ptr->indentation();
+}
+
+size_t RkTreeView::rowsNumber() const
+{
+        return impl_ptr->rowsNumber();
+}
+
+RkTreeView::NodeId RkTreeView::nodeAt(int y) const
+{
+        return impl_ptr->rowNode(impl_ptr->rowAt(y));
+}
+
+RkTreeView::NodeId RkTreeView::selectedNode() const
+{
+        return impl_ptr->selectedNode();
+}
+
+void RkTreeView::selectNode(NodeId node)
+{
+        if (impl_ptr->selectNode(node)) {
+                update();
+                action nodeSelected(node);
+        }
+}
+
+int RkTreeView::scrollOffset() const
+{
+        return impl_ptr->scrollOffset();
+}
+
+void RkTreeView::setScrollOffset(int offset)
+{
+        if (impl_ptr->setScrollOffset(offset)) {
+                update();
+                action scrollOffsetChanged(scrollOffset());
+        }
+}
+
+int RkTreeView::maxScrollOffset() const
+{
+        return impl_ptr->maxScrollOffset();
+}
+
+void RkTreeView::paintEvent(RkPaintEvent *event)
+{
+        RkImage img(size());
+        RkPainter painter(&img);
+        painter.fillRect(rect(), background());
+        impl_ptr->drawTree(painter);
+        RkPainter paint(this);
+        paint.drawImage(img, 0, 0);
+}
+
+void RkTreeView::mouseButtonPressEvent(RkMouseEvent *event)
+{
+        auto span = getModel() ? getModel()->itemSpan() : 0;
+        switch (event->button())
+        {
+        case RkMouseEvent::ButtonType::Left:
+        {
+                auto row = impl_ptr->rowAt(event->y());
+                auto node = impl_ptr->rowNode(row);
+                if (node == RkTreeModel::rootNode)
+                        break;
+                if (impl_ptr->isOnExpander(row, event->x()) && getModel()->hasChildren(node)) {
+                        if (isExpanded(node))
+                                collapse(node);
+                        else
+                                expand(node);
+                } else {
+                        selectNode(node);
+                }
+                break;
+        }
+        case RkMouseEvent::ButtonType::WheelUp:
+                setScrollOffset(scrollOffset() - 3 * span);
+                break;
+        case RkMouseEvent::ButtonType::WheelDown:
+                setScrollOffset(scrollOffset() + 3 * span);
+                break;
+        default:
+                break;
+        }
+}
+
+void RkTreeView::mouseDoubleClickEvent(RkMouseEvent *event)
+{
+        auto row = impl_ptr->rowAt(event->y());
+        auto node = impl_ptr->rowNode(row);
+        if (node == RkTreeModel::rootNode || impl_ptr->isOnExpander(row, event->x()))
+                return;
+        if (isExpanded(node))
+                collapse(node);
+        else if (getModel()->hasChildren(node))
+                expand(node);
+}
@@ -0,0 +1,416 @@
+/**
+ * File name: RkTreeViewImpl.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkTreeViewImpl.h"
+
+#include <algorithm>
+#include <limits>
+
+static constexpr size_t noRow = static_cast<size_t>(-1);
+// Size of the expand sign.
+static constexpr int signSize = 8;
+
+RkTreeView::RkTreeViewImpl::RkTreeViewImpl(RkTreeView *interface,
+                                           RkWidget *parent,
+                                           RkTreeModel *model)
+    : RkWidgetImpl(static_cast<RkWidget*>(interface), parent)
+    , inf_ptr{interface}
+    , treeModel{model}
+    , indexedRows{0}
+    , selectedTreeNode{RkTreeModel::rootNode}
+    , treeIndentation{16}
+    , leftMargin{4}
+    , treeScrollOffset{0}
+{
+        expandedSign.moveTo(RkRealPoint(0, 2));
+        expandedSign.lineTo(RkRealPoint(signSize, 2));
+        expandedSign.lineTo(RkRealPoint(signSize / 2, signSize - 1));
+        expandedSign.close();
+        collapsedSign.moveTo(RkRealPoint(2, 0));
+        collapsedSign.lineTo(RkRealPoint(signSize - 1, signSize / 2));
+        collapsedSign.lineTo(RkRealPoint(2, signSize));
+        collapsedSign.close();
+}
+
+RkTreeModel* RkTreeView::RkTreeViewImpl::getModel() const
+{
+        return treeModel;
+}
+
+bool RkTreeView::RkTreeViewImpl::expand(NodeId node)
+{
+        if (node == RkTreeModel::rootNode || !expandedNodes.insert(node).second)
+                return false;
+
+        auto row = findRow(node);
+        if (row == noRow)
+                return true;
+
+        auto n = treeModel->childrenNumber(node);
+        if (n < 1)
+                return true;
+
+        std::vector<Row> rows;
+        addChildren(rows, node, treeRows[row].depth + 1, 0, n - 1);
+        insertRows(row + 1, node, rows);
+        rowsInserted(row + 1, rows.size());
+        return true;
+}
+
+bool RkTreeView::RkTreeViewImpl::collapse(NodeId node)
+{
+        if (expandedNodes.erase(node) == 0)
+                return false;
+
+        auto row = findRow(node);
+        if (row == noRow)
+                return true;
+
+        auto end = subtreeEnd(row);
+        eraseRows(row + 1, end, node);
+        rowsRemoved(row + 1, end - row - 1);
+        return true;
+}
+
+bool RkTreeView::RkTreeViewImpl::isExpanded(NodeId node) const
+{
+        return expandedNodes.find(node) != expandedNodes.end();
+}
+
+void RkTreeView::RkTreeViewImpl::setIndentation(int indentation)
+{
+        treeIndentation = std::max(indentation, signSize);
+}
+
+int RkTreeView::RkTreeViewImpl::indentation() const
+{
+        return treeIndentation;
+}
+
+size_t RkTreeView::RkTreeViewImpl::rowsNumber() const
+{
+        return treeRows.size();
+}
+
+size_t RkTreeView::RkTreeViewImpl::rowAt(int y) const
+{
+        auto span = treeModel ? treeModel->itemSpan() : 0;
+        if (span < 1 || y < 0)
+                return noRow;
+
+        auto row = static_cast<size_t>((y + treeScrollOffset) / span);
+        return row < treeRows.size() ? row : noRow;
+}
+
+RkTreeModel::NodeId RkTreeView::RkTreeViewImpl::rowNode(size_t row) const
+{
+        return row < treeRows.size() ? treeRows[row].node : RkTreeModel::rootNode;
+}
+
+bool RkTreeView::RkTreeViewImpl::isOnExpander(size_t row, int x) const
+{
+        if (row >= treeRows.size())
+                return false;
+        auto left = leftMargin + treeRows[row].depth * treeIndentation;
+        return x >= left && x < left + treeIndentation;
+}
+
+RkTreeModel::NodeId RkTreeView::RkTreeViewImpl::selectedNode() const
+{
+        return selectedTreeNode;
+}
+
+bool RkTreeView::RkTreeViewImpl::selectNode(NodeId node)
+{
+        if (node == selectedTreeNode)
+                return false;
+        selectedTreeNode = node;
+        return true;
+}
+
+int RkTreeView::RkTreeViewImpl::scrollOffset() const
+{
+        return treeScrollOffset;
+}
+
+bool RkTreeView::RkTreeViewImpl::setScrollOffset(int offset)
+{
+        offset = std::clamp(offset, 0, maxScrollOffset());
+        if (offset == treeScrollOffset)
+                return false;
+        treeScrollOffset = offset;
+        return true;
+}
+
+int RkTreeView::RkTreeViewImpl::maxScrollOffset() const
+{
+        if (!treeModel)
+                return 0;
+        auto contentHeight = static_cast<long long>(treeRows.size()) * treeModel->itemSpan();
+        auto offset = contentHeight - inf_ptr->height();
+        return static_cast<int>(std::clamp<long long>(offset, 0, std::numeric_limits<int>::max()));
+}
+
+void RkTreeView::RkTreeViewImpl::drawTree(RkPainter &painter)
+{
+        auto visible = visibleRows();
+        if (visible.first >= visible.second)
+                return;
+
+        auto span = treeModel->itemSpan();
+        auto bounds = painter.clipBounds();
+        const RkPen defaultPen = painter.pen();
+        for (auto i = visible.first; i < visible.second; i++) {
+                const auto &row = treeRows[i];
+                int y = static_cast<int>(i) * span - treeScrollOffset;
+                if (y + span <= bounds.top() || y >= bounds.bottom())
+                        continue;
+
+                RkPen pen = defaultPen;
+                auto data = treeModel->nodeData(row.node, static_cast<int>(RkModelItem::DataType::Color));
+                if (std::holds_alternative<RkColor>(data))
+                        pen.setColor(std::get<RkColor>(data));
+                if (row.node == selectedTreeNode)
+                        pen.setColor({255, 255, 255});
+                painter.setPen(pen);
+
+                int x = leftMargin + row.depth * treeIndentation;
+                if (treeModel->hasChildren(row.node)) {
+                        painter.save();
+                        painter.translate(RkPoint(x + (treeIndentation - signSize) / 2, y + (span - signSize) / 2));
+                        painter.fillPath(isExpanded(row.node) ? expandedSign : collapsedSign, pen.color());
+                        painter.restore();
+                }
+
+                data = treeModel->nodeData(row.node, static_cast<int>(RkModelItem::DataType::String));
+                if (std::holds_alternative<std::string>(data)) {
+                        x += treeIndentation;
+                        painter.drawText(RkRect(x, y, inf_ptr->width() - x, span),
+                                         std::get<std::string>(data),
+                                         Rk::Alignment::AlignLeft);
+                }
+        }
+        painter.setPen(defaultPen);
+}
+
+void RkTreeView::RkTreeViewImpl::reset()
+{
+        treeRows.clear();
+        rowIndex.clear();
+        indexedRows = 0;
+        if (treeModel) {
+                auto n = treeModel->childrenNumber(RkTreeModel::rootNode);
+                if (n > 0)
+                        addChildren(treeRows, RkTreeModel::rootNode, 0, 0, n - 1);
+        }
+        setScrollOffset(treeScrollOffset);
+}
+
+bool RkTreeView::RkTreeViewImpl::childrenInserted(NodeId parent, size_t first, size_t last)
+{
+        size_t parentRow = noRow;
+        if (parent != RkTreeModel::rootNode) {
+                if (!isExpanded(parent))
+                        return false;
+                parentRow = findRow(parent);
+                if (parentRow == noRow)
+                        return false;
+        }
+
+        std::vector<Row> rows;
+        auto depth = parentRow == noRow ? 0 : treeRows[parentRow].depth + 1;
+        addChildren(rows, parent, depth, first, last);
+        auto row = childRow(parentRow, first);
+        insertRows(row, parent, rows);
+        return rowsInserted(row, rows.size());
+}
+
+bool RkTreeView::RkTreeViewImpl::childrenRemoved(NodeId parent, size_t first, size_t last)
+{
+        size_t parentRow = noRow;
+        if (parent != RkTreeModel::rootNode) {
+                if (!isExpanded(parent))
+                        return false;
+                parentRow = findRow(parent);
+                if (parentRow == noRow)
+                        return false;
+        }
+
+        auto parentEnd = parentRow == noRow ? treeRows.size() : subtreeEnd(parentRow);
+        auto row = childRow(parentRow, first);
+        auto end = row;
+        for (auto i = first; i <= last && end < parentEnd; i++)
+                end = subtreeEnd(end);
+
+        for (auto i = row; i < end; i++) {
+                expandedNodes.erase(treeRows[i].node);
+                if (treeRows[i].node == selectedTreeNode)
+                        selectedTreeNode = RkTreeModel::rootNode;
+        }
+        eraseRows(row, end, parent);
+        return rowsRemoved(row, end - row);
+}
+
+bool RkTreeView::RkTreeViewImpl::nodeChanged(NodeId node) const
+{
+        auto visible = visibleRows();
+        for (auto i = visible.first; i < visible.second; i++) {
+                if (treeRows[i].node == node)
+                        return true;
+        }
+        return false;
+}
+
+size_t RkTreeView::RkTreeViewImpl::findRow(NodeId node) const
+{
+        if (node == RkTreeModel::rootNode)
+                return noRow;
+
+        // The entries of the rows moved by a change are stale even below
+        // indexedRows, when the rows were indexed again up to another node.
+        auto res = rowIndex.find(node);
+        if (res != rowIndex.end() && res->second < indexedRows && treeRows[res->second].node == node)
+                return res->second;
+
+        // A stale node is after the indexed rows, they are all up to date.
+        while (indexedRows < treeRows.size()) {
+                auto row = indexedRows++;
+                rowIndex[treeRows[row].node] = row;
+                if (treeRows[row].node == node)
+                        return row;
+        }
+        return noRow;
+}
+
+void RkTreeView::RkTreeViewImpl::insertRows(size_t row, NodeId parent, const std::vector<Row> &rows)
+{
+        if (rows.empty())
+                return;
+        treeRows.insert(treeRows.begin() + row, rows.begin(), rows.end());
+        indexedRows = std::min(indexedRows, row);
+        addDescendants(parent, rows.size(), false);
+}
+
+void RkTreeView::RkTreeViewImpl::eraseRows(size_t row, size_t end, NodeId parent)
+{
+        if (row >= end)
+                return;
+        for (auto i = row; i < end; i++)
+                rowIndex.erase(treeRows[i].node);
+        treeRows.erase(treeRows.begin() + row, treeRows.begin() + end);
+        indexedRows = std::min(indexedRows, row);
+        addDescendants(parent, end - row, true);
+}
+
+void RkTreeView::RkTreeViewImpl::addDescendants(NodeId parent, size_t count, bool removed)
+{
+        // The ancestors are above the changed rows, so their rows didn't move.
+        while (parent != RkTreeModel::rootNode) {
+                auto row = findRow(parent);
+                if (row == noRow)
+                        return;
+                auto &ancestor = treeRows[row];
+                if (removed)
+                        ancestor.descendants -= count;
+                else
+                        ancestor.descendants += count;
+                parent = ancestor.parent;
+        }
+}
+
+size_t RkTreeView::RkTreeViewImpl::subtreeEnd(size_t row) const
+{
+        if (row >= treeRows.size())
+                return treeRows.size();
+        return row + 1 + treeRows[row].descendants;
+}
+
+size_t RkTreeView::RkTreeViewImpl::childRow(size_t parentRow, size_t index) const
+{
+        auto row = parentRow == noRow ? 0 : parentRow + 1;
+        auto end = parentRow == noRow ? treeRows.size() : subtreeEnd(parentRow);
+        for (size_t i = 0; i < index && row < end; i++)
+                row = subtreeEnd(row);
+        return row;
+}
+
+void RkTreeView::RkTreeViewImpl::addChildren(std::vector<Row> &rows,
+                                             NodeId parent,
+                                             int depth,
+                                             size_t first,
+                                             size_t last) const
+{
+        auto n = treeModel->childrenNumber(parent);
+        for (auto i = first; i <= last && i < n; i++) {
+                auto node = treeModel->child(parent, i);
+                auto row = rows.size();
+                rows.push_back({node, parent, depth, 0});
+                auto childrenNumber = isExpanded(node) ? treeModel->childrenNumber(node) : 0;
+                if (childrenNumber > 0)
+                        addChildren(rows, node, depth + 1, 0, childrenNumber - 1);
+                rows[row].descendants = rows.size() - row - 1;
+        }
+}
+
+std::pair<size_t, size_t> RkTreeView::RkTreeViewImpl::visibleRows() const
+{
+        if (!treeModel || treeModel->itemSpan() < 1)
+                return {0, 0};
+
+        auto span = treeModel->itemSpan();
+        auto first = static_cast<size_t>(treeScrollOffset / span);
+        auto last = std::min(static_cast<size_t>((treeScrollOffset + inf_ptr->height() + span - 1) / span),
+                             treeRows.size());
+        return {first, std::max(first, last)};
+}
+
+bool RkTreeView::RkTreeViewImpl::rowsInserted(size_t row, size_t count)
+{
+        if (count < 1)
+                return false;
+
+        auto visible = visibleRows();
+        if (row < visible.first) {
+                setScrollOffset(treeScrollOffset + static_cast<int>(count) * treeModel->itemSpan());
+                return false;
+        }
+        return row < visible.second;
+}
+
+bool RkTreeView::RkTreeViewImpl::rowsRemoved(size_t row, size_t count)
+{
+        if (count < 1)
+                return false;
+
+        auto visible = visibleRows();
+        auto span = treeModel->itemSpan();
+        if (row + count <= visible.first) {
+                setScrollOffset(treeScrollOffset - static_cast<int>(count) * span);
+                return false;
+        }
+        if (row < visible.first)
+                setScrollOffset(static_cast<int>(row) * span);
+        else
+                setScrollOffset(treeScrollOffset);
+        return true;
+}
@@ -28,6 +28,8 @@
 #include "RkPlatform.h"
 #include "RkMain.h"
 
+#include <algorithm>
+
 RkWidget::RkWidget(RkMain *mainApp, Rk::WindowFlags flags)
         : RkObject(nullptr, std::make_unique<RkWidgetImpl>(this, nullptr, flags, true))
         , impl_ptr{static_cast<RkWidgetImpl*>(o_ptr.get())}
@@ -600,6 +602,47 @@ bool RkWidget::isTopWindow() const
         return !parentWidget();
 }
 
+RkWidget* RkWidget::widgetAt(const RkPoint &point)
+{
+        auto index = impl_ptr->widgetIndex();
+        auto origin = impl_ptr->indexPosition();
+        RkPoint indexPoint(origin.x() + point.x(), origin.y() + point.y());
+        if (!parentWidget() || parentWidget()->impl_ptr->widgetIndex() != index)
+                return index->widgetAt(indexPoint);
+
+        auto widgets = index->widgetsAt(indexPoint);
+        for (auto it = widgets.rbegin(); it != widgets.rend(); ++it) {
+                for (auto widget = *it; widget && widget->impl_ptr->widgetIndex() == index;
+                     widget = widget->parentWidget()) {
+                        if (widget == this)
+                                return *it;
+                }
+        }
+        return nullptr;
+}
+
+std::vector<RkWidget*> RkWidget::widgetsIn(const RkRect &rect)
+{
+        auto index = impl_ptr->widgetIndex();
+        auto origin = impl_ptr->indexPosition();
+        RkRect indexRect(RkPoint(origin.x() + rect.left(), origin.y() + rect.top()), rect.size());
+        auto widgets = index->widgets(indexRect);
+        if (!parentWidget() || parentWidget()->impl_ptr->widgetIndex() != index)
+                return widgets;
+
+        auto isChild = [this, index](RkWidget *widget) {
+                for (; widget && widget->impl_ptr->widgetIndex() == index; widget = widget->parentWidget()) {
+                        if (widget == this)
+                                return true;
+                }
+                return false;
+        };
+        widgets.erase(std::remove_if(widgets.begin(), widgets.end(),
+                                     [&isChild](RkWidget *widget) { return !isChild(widget); }),
+                      widgets.end());
+        return widgets;
+}
+
 void RkWidget::setFocus(bool b)
 {
         impl_ptr->setFocus(b);
@@ -61,9 +61,12 @@ RkWidget::RkWidgetImpl::RkWidgetImpl(RkWidget* widgetInterface, RkWidget* parent
 	, isWidgetSown{false}
         , isGrabKeyEnabled{false}
         , isPropagateGrabKey{true}
+        , parentImpl{nullptr}
+        , topIndex{nullptr}
 {
         RK_LOG_DEBUG("called");
         platformWindow->init();
+        initIndex(parent, flags, isTopWindow);
 }
 
 RkWidget::RkWidgetImpl::RkWidgetImpl(RkWidget* widgetInterface,
@@ -87,15 +90,92 @@ RkWidget::RkWidgetImpl::RkWidgetImpl(RkWidget* widgetInterface,
         , widgetTextColor{0, 0, 0}
         , widgetDrawingColor{0, 0, 0}
         , widgetPointerShape{Rk::PointerShape::Arrow}
+        , isWidgetSown{false}
         , isGrabKeyEnabled{false}
+        , parentImpl{nullptr}
+        , topIndex{nullptr}
 {
         RK_LOG_DEBUG("called");
         platformWindow->init();
+        initIndex(nullptr, flags, isTopWindow);
 }
 
 RkWidget::RkWidgetImpl::~RkWidgetImpl()
 {
         RK_LOG_DEBUG("called");
+        // The children are deleted before, the top widget index is deleted after.
+        if (topIndex)
+                topIndex->remove(inf_ptr);
+}
+
+void RkWidget::RkWidgetImpl::initIndex(RkWidget *parent, Rk::WindowFlags flags, bool isTopWindow)
+{
+        static uint64_t creationCounter = 0;
+        constexpr auto ownWindowFlags = static_cast<int>(Rk::WindowFlags::Dialog)
+                | static_cast<int>(Rk::WindowFlags::Popup);
+        if (parent && !isTopWindow && !(static_cast<int>(flags) & ownWindowFlags)) {
+                parentImpl = parent->impl_ptr;
+                topIndex = parentImpl->topIndex;
+                widgetStackOrder = parentImpl->widgetStackOrder;
+        } else {
+                topWidgetIndex = std::make_unique<RkWidgetIndex>();
+                topIndex = topWidgetIndex.get();
+        }
+        widgetStackOrder.push_back(++creationCounter);
+}
+
+/**
+ * Updates the rectangle of the widget and of its children in the index of
+ * the top widget. A widget is in the index when it and all its parents are
+ * shown, with its rectangle clipped by the parents.
+ */
+void RkWidget::RkWidgetImpl::updateIndex()
+{
+        RkRect rect;
+        RkPoint position;
+        if (!parentImpl) {
+                if (isWidgetSown)
+                        rect = RkRect(position, widgetSize);
+        } else {
+                position = RkPoint(parentImpl->topIndexPosition.x() + widgetPosition.x(),
+                                   parentImpl->topIndexPosition.y() + widgetPosition.y());
+                if (isWidgetSown && topIndex->contains(parentImpl->inf_ptr))
+                        rect = RkRect(position, widgetSize).intersected(topIndex->rect(parentImpl->inf_ptr));
+        }
+
+        if (rect.area() <= 0)
+                rect = RkRect();
+
+        // The children depend only on the origin and the visible rectangle.
+        auto indexedRect = topIndex->rect(inf_ptr);
+        if (position == topIndexPosition && rect == indexedRect)
+                return;
+
+        topIndexPosition = position;
+        if (rect.area() > 0)
+                topIndex->update(inf_ptr, rect, widgetStackOrder);
+        else if (indexedRect.area() > 0)
+                topIndex->remove(inf_ptr);
+        else
+                return;
+
+        for (const auto &child: getChildren()) {
+                if (child->type() != Rk::ObjectType::Widget)
+                        continue;
+                auto childImpl = static_cast<RkWidget*>(child)->impl_ptr;
+                if (childImpl->parentImpl == this)
+                        childImpl->updateIndex();
+        }
+}
+
+RkWidgetIndex* RkWidget::RkWidgetImpl::widgetIndex() const
+{
+        return topIndex;
+}
+
+RkPoint RkWidget::RkWidgetImpl::indexPosition() const
+{
+        return topIndexPosition;
 }
 
 Rk::WindowFlags RkWidget::RkWidgetImpl::windowFlags() const
@@ -115,6 +195,7 @@ void RkWidget::RkWidgetImpl::show(bool b)
 {
 	isWidgetSown = b;
         platformWindow->show(isWidgetSown);
+        updateIndex();
 }
 
 bool RkWidget::RkWidgetImpl::isShown() const
@@ -209,15 +290,18 @@ void RkWidget::RkWidgetImpl::event(RkEvent *event)
                 break;
         case RkEvent::Type::Resize:
                 widgetSize = platformWindow->size();
+                updateIndex();
                 platformWindow->resizeCanvas();
                 inf_ptr->resizeEvent(static_cast<RkResizeEvent*>(event));
                 break;
 	case RkEvent::Type::Show:
 		isWidgetSown = true;
+                updateIndex();
                 inf_ptr->showEvent(static_cast<RkShowEvent*>(event));
                 break;
 	case RkEvent::Type::Hide:
 		isWidgetSown = false;
+                updateIndex();
                 inf_ptr->hideEvent(static_cast<RkHideEvent*>(event));
                 break;
         case RkEvent::Type::DeleteChild:
@@ -242,6 +326,7 @@ void RkWidget::RkWidgetImpl::setSize(const RkSize &size)
         if (size.width() > 1 && size.height() > 1)
                 platformWindow->setSize(size);
         widgetSize = size;
+        updateIndex();
 }
 
 RkSize RkWidget::RkWidgetImpl::size() const
@@ -292,10 +377,15 @@ void RkWidget::RkWidgetImpl::setMaximumHeight(int height)
 void RkWidget::RkWidgetImpl::setPosition(const RkPoint &position)
 {
         platformWindow->setPosition(position);
+        widgetPosition = position;
+        updateIndex();
 }
 
 RkPoint RkWidget::RkWidgetImpl::position() const
 {
+        // Only the top widgets are moved by others, by the window manager.
+        if (parentImpl)
+                return widgetPosition;
         return platformWindow->position();
 }
 
@@ -0,0 +1,233 @@
+/**
+ * File name: RkWidgetIndex.cpp
+ * Project: Redkite (A small GUI toolkit)
+ *
+ * Copyright (C) 2019 Iurie Nistor <http://geontime.com>
+ *
+ * This file is part of Redkite.
+ *
+ * Redkite is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "RkWidgetIndex.h"
+
+#include <algorithm>
+
+RkWidgetIndex::RkWidgetIndex(int cellSize)
+        : indexCellSize{std::max(cellSize, 1)}
+        , queryCounter{0}
+{
+}
+
+void RkWidgetIndex::update(RkWidget *widget, const RkRect &rect, const std::vector<uint64_t> &stackOrder)
+{
+        if (rect.width() < 1 || rect.height() < 1) {
+                remove(widget);
+                return;
+        }
+
+        auto &entry = indexEntries[widget];
+        if (!entry) {
+                entry = std::make_unique<Entry>();
+                entry->widget = widget;
+                entry->isLarge = false;
+                entry->queryId = 0;
+                entry->stackOrder = stackOrder;
+        } else if (entry->rect == rect) {
+                return;
+        } else {
+                removeCells(entry.get());
+        }
+
+        entry->rect = rect;
+        insertCells(entry.get());
+}
+
+void RkWidgetIndex::remove(RkWidget *widget)
+{
+        auto res = indexEntries.find(widget);
+        if (res == indexEntries.end())
+                return;
+        removeCells(res->second.get());
+        indexEntries.erase(res);
+}
+
+bool RkWidgetIndex::contains(RkWidget *widget) const
+{
+        return indexEntries.find(widget) != indexEntries.end();
+}
+
+RkRect RkWidgetIndex::rect(RkWidget *widget) const
+{
+        auto res = indexEntries.find(widget);
+        if (res != indexEntries.end())
+                return res->second->rect;
+        return RkRect();
+}
+
+int RkWidgetIndex::cell(int coordinate) const
+{
+        // Rounds down for the negative coordinates too.
+        return coordinate >= 0 ? coordinate / indexCellSize
+                : -((-coordinate + indexCellSize - 1) / indexCellSize);
+}
+
+uint64_t RkWidgetIndex::cellKey(int column, int row)
+{
+        return (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32)
+                | static_cast<uint32_t>(column);
+}
+
+void RkWidgetIndex::insertCells(Entry *entry)
+{
+        const auto &rect = entry->rect;
+        auto firstColumn = cell(rect.left());
+        auto lastColumn = cell(rect.right() - 1);
+        auto firstRow = cell(rect.top());
+        auto lastRow = cell(rect.bottom() - 1);
+        auto cells = static_cast<long long>(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+        entry->isLarge = cells > largeEntryCells;
+        if (entry->isLarge) {
+                largeEntries.push_back(entry);
+                return;
+        }
+
+        for (auto row = firstRow; row <= lastRow; row++) {
+                for (auto column = firstColumn; column <= lastColumn; column++)
+                        indexCells[cellKey(column, row)].push_back(entry);
+        }
+}
+
+void RkWidgetIndex::removeCells(Entry *entry)
+{
+        auto erase = [entry](std::vector<Entry*> &entries) {
+                auto res = std::find(entries.begin(), entries.end(), entry);
+                if (res != entries.end()) {
+                        *res = entries.back();
+                        entries.pop_back();
+                }
+        };
+
+        if (entry->isLarge) {
+                erase(largeEntries);
+                return;
+        }
+
+        const auto &rect = entry->rect;
+        for (auto row = cell(rect.top()); row <= cell(rect.bottom() - 1); row++) {
+                for (auto column = cell(rect.left()); column <= cell(rect.right() - 1); column++) {
+                        auto res = indexCells.find(cellKey(column, row));
+                        if (res == indexCells.end())
+                                continue;
+                        erase(res->second);
+                        if (res->second.empty())
+                                indexCells.erase(res);
+                }
+        }
+}
+
+RkWidget* RkWidgetIndex::widgetAt(const RkPoint &point) const
+{
+        const Entry *top = nullptr;
+        auto check = [&top, &point](const Entry *entry) {
+                if (entry->rect.contains(point) && (!top || top->stackOrder < entry->stackOrder))
+                        top = entry;
+        };
+
+        auto res = indexCells.find(cellKey(cell(point.x()), cell(point.y())));
+        if (res != indexCells.end()) {
+                for (const auto &entry: res->second)
+                        check(entry);
+        }
+        for (const auto &entry: largeEntries)
+                check(entry);
+        return top ? top->widget : nullptr;
+}
+
+std::vector<RkWidget*> RkWidgetIndex::widgetsAt(const RkPoint &point) const
+{
+        std::vector<const Entry*> entries;
+        auto res = indexCells.find(cellKey(cell(point.x()), cell(point.y())));
+        if (res != indexCells.end()) {
+                for (const auto &entry: res->second) {
+                        if (entry->rect.contains(point))
+                                entries.push_back(entry);
+                }
+        }
+        for (const auto &entry: largeEntries) {
+                if (entry->rect.contains(point))
+                        entries.push_back(entry);
+        }
+        return sorted(entries);
+}
+
+std::vector<RkWidget*> RkWidgetIndex::widgets(const RkRect &rect) const
+{
+        std::vector<const Entry*> entries;
+        if (rect.width() < 1 || rect.height() < 1)
+                return {};
+
+        auto firstColumn = cell(rect.left());
+        auto lastColumn = cell(rect.right() - 1);
+        auto firstRow = cell(rect.top());
+        auto lastRow = cell(rect.bottom() - 1);
+        auto cells = static_cast<long long>(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+        if (cells > static_cast<long long>(indexCells.size())) {
+                // Fewer occupied cells than cells under the rectangle.
+                for (const auto &entry: indexEntries) {
+                        if (entry.second->rect.intersects(rect))
+                                entries.push_back(entry.second.get());
+                }
+                return sorted(entries);
+        }
+
+        // A widget is in several cells, the query id skips the repeated ones.
+        auto queryId = ++queryCounter;
+        for (auto row = firstRow; row <= lastRow; row++) {
+                for (auto column = firstColumn; column <= lastColumn; column++) {
+                        auto res = indexCells.find(cellKey(column, row));
+                        if (res == indexCells.end())
+                                continue;
+                        for (const auto &entry: res->second) {
+                                if (entry->queryId != queryId && entry->rect.intersects(rect)) {
+                                        entry->queryId = queryId;
+                                        entries.push_back(entry);
+                                }
+                        }
+                }
+        }
+        for (const auto &entry: largeEntries) {
+                if (entry->rect.intersects(rect))
+                        entries.push_back(entry);
+        }
+        return sorted(entries);
+}
+
+std::vector<RkWidget*> RkWidgetIndex::sorted(std::vector<const Entry*> &entries) const
+{
+        std::sort(entries.begin(), entries.end(), [](const Entry *a, const Entry *b) {
+                        return a->stackOrder < b->stackOrder;
+                });
+        std::vector<RkWidget*> widgets;
+        widgets.reserve(entries.size());
+        for (const auto &entry: entries)
+                widgets.push_back(entry->widget);
+        return widgets;
+}
+
+size_t RkWidgetIndex::size() const
+{
+        return indexEntries.size();
+}
@@ -91,6 +91,14 @@ RkEventQueueX::getEvents()
                         event->setType(RkEvent::Type::MouseButtonRelease);
                         break;
                 case MotionNotify:
+                        // Only the latest of consecutive moves over the same window matters.
+                        while (pending()) {
+                                XEvent next;
+                                XPeekEvent(xDisplay, &next);
+                                if (next.type != MotionNotify || next.xmotion.window != e.xmotion.window)
+                                        break;
+                                XNextEvent(xDisplay, &e);
+                        }
                         event = getMouseMove(&e);
                         break;
                 case ConfigureNotify:
@@ -23,56 +23,378 @@
 
 /**
  * rkpng2c is a part of Redkite GUI toolkit.
- * It converts a PNG image to C array encoded in ARGB32 format.
+ * It converts a PNG image to C array encoded in ARGB32 format,
+ * or to a compact resource (see include/impl/RkImageDecoder.h).
  */
 
-#define RK_VERSION_STR "1.0.0"
+#define RK_VERSION_STR "1.2.0"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <libgen.h>
+#include <dirent.h>
 #include <cairo/cairo.h>
 
+#define RK_ENCODING_RAW 0
+#define RK_ENCODING_COMPRESSED 1
+#define RK_HEADER_SIZE 20
+
+struct rk_buffer {
+        unsigned char *data;
+        size_t size;
+        size_t capacity;
+};
+
+static void print_usage(void)
+{
+        printf("Redkite GUI toolkit\n");
+        printf("rkpng2c version %s\n", RK_VERSION_STR);
+        printf("Converts a PNG to C array encoded in ARGB32 or A8\n");
+        printf("Copyright (C) 2019 Iurie Nistor <iur.nistor@gmail.com>\n");
+        printf("License GPLv2\n");
+        printf("Usage: rkpng2c [-a8] [-c] <PNG file> <C or C++ file> <array name>\n");
+        printf("       rkpng2c -d [-a8] <directory> <C or C++ file> <array name>\n");
+        printf("  -a8  emit one alpha byte per pixel: the alpha channel of\n");
+        printf("       images with alpha, the luminance of grayscale/RGB images\n");
+        printf("  -c   emit a compressed resource, decoded when first used\n");
+        printf("  -d   pack all the PNG files of the directory into one\n");
+        printf("       compressed resource blob\n");
+}
+
+static void buffer_append(struct rk_buffer *buffer, const void *data, size_t n)
+{
+        if (buffer->size + n > buffer->capacity) {
+                buffer->capacity = 2 * (buffer->size + n);
+                buffer->data = realloc(buffer->data, buffer->capacity);
+                if (buffer->data == NULL) {
+                        printf("out of memory\n");
+                        exit(1);
+                }
+        }
+        memcpy(buffer->data + buffer->size, data, n);
+        buffer->size += n;
+}
+
+static void buffer_append_byte(struct rk_buffer *buffer, unsigned char value)
+{
+        buffer_append(buffer, &value, 1);
+}
+
+static void buffer_append_uint16(struct rk_buffer *buffer, unsigned int value)
+{
+        buffer_append_byte(buffer, value & 0xff);
+        buffer_append_byte(buffer, (value >> 8) & 0xff);
+}
+
+static void buffer_append_uint32(struct rk_buffer *buffer, unsigned int value)
+{
+        buffer_append_uint16(buffer, value & 0xffff);
+        buffer_append_uint16(buffer, value >> 16);
+}
+
+static void buffer_set_uint32(struct rk_buffer *buffer, size_t pos, unsigned int value)
+{
+        for (int i = 0; i < 4; i++)
+                buffer->data[pos + i] = (value >> (8 * i)) & 0xff;
+}
+
+/**
+ * Returns the A8 value of a pixel: alpha for ARGB32 images,
+ * luminance (Rec. 601) for opaque RGB24 images.
+ */
+static unsigned char a8_value(const unsigned char *pixel, cairo_format_t format)
+{
+        unsigned int argb = *(const unsigned int*)pixel;
+        if (format == CAIRO_FORMAT_ARGB32)
+                return argb >> 24;
+        unsigned int r = (argb >> 16) & 0xff;
+        unsigned int g = (argb >> 8) & 0xff;
+        unsigned int b = argb & 0xff;
+        return (r * 77 + g * 150 + b * 29 + 128) >> 8;
+}
+
+/**
+ * Loads the PNG file into a buffer with tightly packed rows,
+ * native endian ARGB32 pixels or one A8 byte per pixel.
+ */
+static int load_image(const char *file, int a8, int *w, int *h, struct rk_buffer *pixels)
+{
+        cairo_surface_t *image = cairo_image_surface_create_from_png(file);
+        if (cairo_surface_status(image) != CAIRO_STATUS_SUCCESS) {
+                printf("can't load image %s\n", file);
+                cairo_surface_destroy(image);
+                return 0;
+        }
+
+        *w = cairo_image_surface_get_width(image);
+        *h = cairo_image_surface_get_height(image);
+        int stride = cairo_image_surface_get_stride(image);
+        cairo_format_t format = cairo_image_surface_get_format(image);
+        const unsigned char *buff = cairo_image_surface_get_data(image);
+        for (int y = 0; y < *h; y++) {
+                const unsigned char *row = buff + y * stride;
+                if (a8) {
+                        for (int x = 0; x < *w; x++)
+                                buffer_append_byte(pixels, a8_value(row + 4 * x, format));
+                } else {
+                        buffer_append(pixels, row, 4 * *w);
+                }
+        }
+        cairo_surface_destroy(image);
+        return 1;
+}
+
+static void encode_qoi(struct rk_buffer *out, const unsigned char *pixels, int n)
+{
+        unsigned int index[64] = {0};
+        unsigned int prev = 0xff000000;
+        int run = 0;
+        for (int i = 0; i < n; i++) {
+                unsigned int px;
+                memcpy(&px, pixels + 4 * i, 4);
+                if (px == prev) {
+                        if (++run == 62 || i == n - 1) {
+                                buffer_append_byte(out, 0xc0 | (run - 1));
+                                run = 0;
+                        }
+                        continue;
+                }
+                if (run > 0) {
+                        buffer_append_byte(out, 0xc0 | (run - 1));
+                        run = 0;
+                }
+
+                unsigned char a = px >> 24, r = (px >> 16) & 0xff, g = (px >> 8) & 0xff, b = px & 0xff;
+                int hash = (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+                if (index[hash] == px) {
+                        buffer_append_byte(out, hash);
+                } else {
+                        index[hash] = px;
+                        if (a == (prev >> 24)) {
+                                signed char vr = r - ((prev >> 16) & 0xff);
+                                signed char vg = g - ((prev >> 8) & 0xff);
+                                signed char vb = b - (prev & 0xff);
+                                signed char vg_r = vr - vg;
+                                signed char vg_b = vb - vg;
+                                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                                        buffer_append_byte(out, 0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                                } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                                        buffer_append_byte(out, 0x80 | (vg + 32));
+                                        buffer_append_byte(out, (vg_r + 8) << 4 | (vg_b + 8));
+                                } else {
+                                        unsigned char rgb[4] = {0xfe, r, g, b};
+                                        buffer_append(out, rgb, 4);
+                                }
+                        } else {
+                                unsigned char rgba[5] = {0xff, r, g, b, a};
+                                buffer_append(out, rgba, 5);
+                        }
+                }
+                prev = px;
+        }
+}
+
+static void encode_rle(struct rk_buffer *out, const unsigned char *pixels, int n)
+{
+        int i = 0;
+        while (i < n) {
+                int run = 1;
+                while (i + run < n && run < 129 && pixels[i + run] == pixels[i])
+                        run++;
+                if (run > 1) {
+                        buffer_append_byte(out, run + 126);
+                        buffer_append_byte(out, pixels[i]);
+                        i += run;
+                        continue;
+                }
+
+                int literal = 1;
+                while (i + literal < n && literal < 128
+                       && (i + literal + 1 >= n || pixels[i + literal] != pixels[i + literal + 1]))
+                        literal++;
+                buffer_append_byte(out, literal - 1);
+                buffer_append(out, pixels + i, literal);
+                i += literal;
+        }
+}
+
+static void encode_image(struct rk_buffer *out, const struct rk_buffer *pixels,
+                         int w, int h, int a8, int compress)
+{
+        size_t start = out->size;
+        buffer_append(out, "RKI1", 4);
+        buffer_append_byte(out, a8 ? 2 : 0);
+        buffer_append_byte(out, compress ? RK_ENCODING_COMPRESSED : RK_ENCODING_RAW);
+        buffer_append_uint16(out, 0);
+        buffer_append_uint32(out, w);
+        buffer_append_uint32(out, h);
+        buffer_append_uint32(out, 0);
+        if (!compress)
+                buffer_append(out, pixels->data, pixels->size);
+        else if (a8)
+                encode_rle(out, pixels->data, w * h);
+        else
+                encode_qoi(out, pixels->data, w * h);
+        buffer_set_uint32(out, start + 16, out->size - start - RK_HEADER_SIZE);
+}
+
+static void write_array(FILE *fptr, const unsigned char *data, size_t n)
+{
+        for (size_t i = 0; i < n; i++) {
+                if ((i + 1) % 12 == 0)
+                        fprintf(fptr, "0x%02x,\n", data[i]);
+                else
+                        fprintf(fptr, "0x%02x, ", data[i]);
+        }
+        fprintf(fptr, "};\n");
+}
+
+static int compare_names(const void *a, const void *b)
+{
+        return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static int is_png(const char *name)
+{
+        size_t n = strlen(name);
+        return n > 4 && strcmp(name + n - 4, ".png") == 0;
+}
+
+/**
+ * Packs the PNG files of the directory in one blob, the images are
+ * named by the file names without the ".png" extension.
+ */
+static int pack_directory(const char *path, int a8, struct rk_buffer *blob, int *count)
+{
+        DIR *dir = opendir(path);
+        if (dir == NULL) {
+                printf("can't open directory %s\n", path);
+                return 0;
+        }
+
+        char **names = NULL;
+        int n = 0;
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+                if (!is_png(entry->d_name))
+                        continue;
+                names = realloc(names, (n + 1) * sizeof(char*));
+                names[n++] = strdup(entry->d_name);
+        }
+        closedir(dir);
+        qsort(names, n, sizeof(char*), compare_names);
+
+        buffer_append(blob, "RKB1", 4);
+        buffer_append_uint32(blob, n);
+        size_t *offsets = malloc((n + 1) * sizeof(size_t));
+        for (int i = 0; i < n; i++) {
+                size_t length = strlen(names[i]) - 4;
+                buffer_append_uint16(blob, length);
+                buffer_append(blob, names[i], length);
+                offsets[i] = blob->size;
+                buffer_append_uint32(blob, 0);
+        }
+
+        int res = 1;
+        for (int i = 0; i < n && res; i++) {
+                char file[4096];
+                snprintf(file, sizeof(file), "%s/%s", path, names[i]);
+                struct rk_buffer pixels = {NULL, 0, 0};
+                int w, h;
+                res = load_image(file, a8, &w, &h, &pixels);
+                if (res) {
+                        printf("%s: %dx%d\n", names[i], w, h);
+                        buffer_set_uint32(blob, offsets[i], blob->size);
+                        encode_image(blob, &pixels, w, h, a8, 1);
+                }
+                free(pixels.data);
+        }
+
+        for (int i = 0; i < n; i++)
+                free(names[i]);
+        free(names);
+        free(offsets);
+        *count = n;
+        return res;
+}
+
 int main(int argc , char **argv)
 {
-        if (argc != 4) {
-                printf("Redkite GUI toolkit\n");
-                printf("rkpng2c version %s\n", RK_VERSION_STR);
-                printf("Converts a PNG to C array encoded in ARGB32\n");
-                printf("Copyright (C) 2019 Iurie Nistor <iur.nistor@gmail.com>\n");
-                printf("License GPLv2\n");
-                printf("Usage: rkpng2c <PNG file> <C or C++ file> <array name>\n");
+        int a8 = 0;
+        int compress = 0;
+        int directory = 0;
+        int arg = 1;
+        for (; arg < argc && argv[arg][0] == '-'; arg++) {
+                if (strcmp(argv[arg], "-a8") == 0) {
+                        a8 = 1;
+                } else if (strcmp(argv[arg], "-c") == 0) {
+                        compress = 1;
+                } else if (strcmp(argv[arg], "-d") == 0) {
+                        directory = 1;
+                } else {
+                        print_usage();
+                        return 1;
+                }
+        }
+
+        if (argc - arg != 3) {
+                print_usage();
                 return 0;
         }
 
-        cairo_surface_t *image = cairo_image_surface_create_from_png(argv[1]);
-        int w = cairo_image_surface_get_width(image);
-        int h = cairo_image_surface_get_height(image);
-        printf("image size: %dx%d\n", w, h);
+        char **args = argv + arg - 1;
+        struct rk_buffer out = {NULL, 0, 0};
+        char description[256];
+        if (directory) {
+                int count = 0;
+                if (!pack_directory(args[1], a8, &out, &count)) {
+                        free(out.data);
+                        return 1;
+                }
+                snprintf(description, sizeof(description),
+                         " * Directory: %s\n"
+                         " * Images: %d\n"
+                         " * Format: %s, compressed\n",
+                         basename(args[1]), count, a8 ? "A8" : "ARGB32");
+        } else {
+                struct rk_buffer pixels = {NULL, 0, 0};
+                int w, h;
+                if (!load_image(args[1], a8, &w, &h, &pixels))
+                        return 1;
+                printf("image size: %dx%d\n", w, h);
+                if (compress)
+                        encode_image(&out, &pixels, w, h, a8, 1);
+                else
+                        buffer_append(&out, pixels.data, pixels.size);
+                free(pixels.data);
+                snprintf(description, sizeof(description),
+                         " * File name: %s\n"
+                         " * Image size: %dx%d\n"
+                         " * Format: %s%s\n",
+                         basename(args[1]), w, h, a8 ? "A8" : "ARGB32",
+                         compress ? ", compressed" : "");
+        }
 
         FILE *fptr;
-        fptr = fopen(argv[2], "wb");
+        fptr = fopen(args[2], "wb");
         if (fptr == NULL) {
-                printf("can't open file %s\n", argv[2]);
+                printf("can't open file %s\n", args[2]);
+                free(out.data);
                 return 1;
         }
 
-        const unsigned char *buff = cairo_image_surface_get_data(image);
         fprintf(fptr, "/**\n"
                       " * Generated with rkpng2c version %s, part of Redkite GUI toolkit.\n"
-                      " * File name: %s\n"
-                      " * Image size: %dx%d\n"
+                      "%s"
                       " */\n"
                       "\n"
-                "const unsigned char %s[] = {\n", RK_VERSION_STR, basename(argv[1]), w, h, basename(argv[3]));
-        for (int i = 0; i < w * h * 4; i++) {
-                if ((i + 1) == 12 || (i + 1) % 12 == 0)
-                        fprintf(fptr, "0x%02x,\n", buff[i]);
-                else
-                        fprintf(fptr, "0x%02x, ", buff[i]);
-        }
-        fprintf(fptr, "};\n");
+                "const unsigned char %s[] = {\n", RK_VERSION_STR, description, basename(args[3]));
+        write_array(fptr, out.data, out.size);
+        if (directory || compress)
+                printf("resource size: %zu bytes\n", out.size);
 
         fclose(fptr);
-        cairo_surface_destroy(image);
+        free(out.data);
         return 0;
 }